@@ -1,10 +1,27 @@
 #ifndef ARRAY_H
 #define ARRAY_H
 
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
+#include <memory>
 #include "../iterator.h"
 
+namespace internal {
+template<typename Expr, typename = void>
+struct is_array_expr : std::false_type {};
+
+template<typename Expr>
+struct is_array_expr<Expr, std::void_t<decltype(Expr::is_array_expr)>> : std::bool_constant<Expr::is_array_expr> {};
+
+/**
+ * Summary:
+ *      Determines whether a type is a lazy element wise expression (see array_expr.h)
+ */
+template<typename Expr>
+inline constexpr bool is_array_expr_v = is_array_expr<Expr>::value;
+}
+
 template<typename T> struct Array {
   Array() : data{nullptr}, num_elements{0U} {}
 
@@ -19,6 +36,16 @@ template<typename T> struct Array {
     move(rhs);
   }
 
+  /**
+   * Summary:
+   *    Evaluates a lazy element wise expression (see array_expr.h)
+   *    in a single loop
+   */
+  template<typename Expr, typename = std::enable_if_t<internal::is_array_expr_v<Expr>>>
+  Array(const Expr &expr) : data{new T[expr.len()]}, num_elements{expr.len()} {
+    assign(expr);
+  }
+
   ~Array() { delete[] this->data; }
 
   Array &operator=(const Array<T> &rhs) {
@@ -45,14 +72,66 @@ template<typename T> struct Array {
     return *this;
   }
 
+  template<typename Expr, typename = std::enable_if_t<internal::is_array_expr_v<Expr>>>
+  Array &operator=(const Expr &expr) {
+    if (this->num_elements != expr.len()) {
+      // The expression may read from this array (e.g. `a = a + b`), so it
+      // has to be evaluated into a new buffer before the old one goes away
+      return *this = Array<T>(expr);
+    }
+
+    // Every item only reads the items at its own index, so it's safe in place
+    assign(expr);
+
+    return *this;
+  }
+
   template<typename IteratorType>
   static Array<T> from_iterator(IteratorType &iter) {
-    size_t count = iter.clone().count();
-    auto arr = Array<T>(count);
-    for (auto[index, value] : iter.enumerate()) {
-      arr[index] = std::move(value);
+    if constexpr (internal::is_random_access_v<IteratorType>) {
+      // The length is known, so we can fill the array by index
+      // without walking the iterator twice
+      auto arr = Array<T>(iter.len());
+      for (size_t i = 0U; i != arr.len(); ++i) {
+        arr[i] = iter[i];
+      }
+      return arr;
+    } else {
+      std::vector<T> items{};
+      const auto[lower, upper] = iter.size_hint();
+      if (upper.has_value() && *upper == lower) {
+        auto arr = Array<T>(lower);
+        size_t index = 0U;
+        auto v = iter.next();
+        for (; v.has_value() && index != arr.len(); v = iter.next()) {
+          arr[index++] = std::move(*v);
+        }
+        if (!v.has_value() && index == arr.len()) {
+          return arr;
+        }
+
+        // The hint was wrong, so keep the items we've read and buffer the rest
+        items.reserve(index + 1U);
+        for (size_t i = 0U; i != index; ++i) {
+          items.push_back(std::move(arr[i]));
+        }
+        if (v.has_value()) {
+          items.push_back(std::move(*v));
+        }
+      } else {
+        items.reserve(lower);
+      }
+
+      // The length is unknown, so buffer the items instead of walking the
+      // iterator twice. That also keeps the items that an owning iterator
+      // moves out from being consumed by a clone.
+      for (auto v = iter.next(); v.has_value(); v = iter.next()) {
+        items.push_back(std::move(*v));
+      }
+      auto arr = Array<T>(items.size());
+      std::move(items.begin(), items.end(), arr.data);
+      return arr;
     }
-    return arr;
   }
 
   void reserve(size_t size) {
@@ -71,10 +150,12 @@ template<typename T> struct Array {
   struct ArrayIterator : public Iterator<std::reference_wrapper<T>, ArrayIterator> {
     using ItemType = std::reference_wrapper<T>;
 
-    explicit ArrayIterator(const Array<T> &cont) : cont{cont}, cursor{0U} {}
+    explicit ArrayIterator(const Array<T> &cont) : cont{cont}, cursor{0U}, limit{cont.num_elements} {}
+
+    ArrayIterator(const Array<T> &cont, size_t cursor, size_t limit) : cont{cont}, cursor{cursor}, limit{limit} {}
 
     std::optional<ItemType> next() {
-      if (this->cursor < this->cont.get().num_elements) {
+      if (this->cursor < this->limit) {
         ++this->cursor;
         return std::make_optional(std::ref(this->cont.get().data[this->cursor - 1]));
       } else {
@@ -82,15 +163,426 @@ template<typename T> struct Array {
       }
     }
 
+    std::optional<ItemType> next_back() {
+      if (this->cursor < this->limit) {
+        --this->limit;
+        return std::make_optional(std::ref(this->cont.get().data[this->limit]));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+    /**
+     * Summary:
+     *    Random access to the remaining items. Index 0 is the item
+     *    that `next` would yield.
+     */
+    ItemType operator[](size_t index) const { return std::ref(this->cont.get().data[this->cursor + index]); }
+
+    [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+      return std::make_pair(len(), std::make_optional(len()));
+    }
+
+    size_t advance_by(size_t n) {
+      size_t advanced = n < len() ? n : len();
+      this->cursor += advanced;
+      return advanced;
+    }
+
+    size_t advance_back_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->limit -= advanced;
+      return advanced;
+    }
+
+    size_t count() {
+      return advance_by(len());
+    }
+
+    /**
+     * Summary:
+     *    Same as `Iterator::position_of`, but it searches the memory directly
+     */
+    std::optional<size_t> position_of(const std::remove_const_t<T> &value) {
+      const size_t index = internal::find_value<std::remove_const_t<T>>(this->cont.get().data + this->cursor, len(),
+                                                                        value);
+      if (index == len()) {
+        advance_by(len());
+        return std::nullopt;
+      }
+      advance_by(index + 1U);
+      return std::make_optional(index);
+    }
+
     std::reference_wrapper<const Array<T>> cont;
     size_t cursor;
+    size_t limit;
+  };
+
+  /**
+   * Summary:
+   *    An iterator that owns the items it yields and moves them out one by one.
+   *    Copies of the iterator (e.g. the ones that `range for` makes) share the
+   *    same buffer, so only one of them should be consumed. The buffer is freed
+   *    as soon as the iterator is exhausted, or when the last copy is destroyed.
+   *    To get an iterator of this type, call `into_iter` on an `Array` rvalue or `drain`.
+   */
+  struct IntoIter : public Iterator<T, IntoIter> {
+    using ItemType = T;
+
+    IntoIter(std::shared_ptr<T[]> buffer, size_t cursor, size_t limit)
+        : buffer{std::move(buffer)}, cursor{cursor}, limit{limit} {}
+
+    std::optional<ItemType> next() {
+      if (this->cursor < this->limit) {
+        std::optional<ItemType> res = std::make_optional(std::move(this->buffer[this->cursor++]));
+        release_if_exhausted();
+        return res;
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    std::optional<ItemType> next_back() {
+      if (this->cursor < this->limit) {
+        std::optional<ItemType> res = std::make_optional(std::move(this->buffer[--this->limit]));
+        release_if_exhausted();
+        return res;
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+    [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+      return std::make_pair(len(), std::make_optional(len()));
+    }
+
+    size_t advance_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->cursor += advanced;
+      release_if_exhausted();
+      return advanced;
+    }
+
+    size_t count() {
+      return advance_by(len());
+    }
+
+    std::shared_ptr<T[]> buffer;
+    size_t cursor;
+    size_t limit;
+
+  private:
+    void release_if_exhausted() noexcept {
+      if (this->cursor == this->limit) {
+        this->buffer.reset();
+      }
+    }
   };
 
   [[nodiscard]] ArrayIterator iter() const noexcept {
     return ArrayIterator(*static_cast<const Array<T> *>(this));
   }
 
+  /**
+   * Summary:
+   *    Consumes the array and returns an iterator that moves the items out of it,
+   *    so that e.g. strings are relocated into the next collection instead of copied.
+   *    The array is left empty.
+   *
+   * @example:
+   * ```
+   * Array<std::string> words = ...;
+   *
+   * auto long_words = std::move(words).into_iter()
+   *      .filter([](const std::string &w) { return w.size() > 8; })
+   *      .collect<Array>();
+   * ```
+   */
+  [[nodiscard]] IntoIter into_iter() && {
+    const size_t len = this->num_elements;
+    std::shared_ptr<T[]> buffer(this->data);
+    this->data = nullptr;
+    this->num_elements = 0U;
+    return IntoIter(std::move(buffer), 0U, len);
+  }
+
+  /**
+   * Summary:
+   *    Removes the items in `[first, last)` from the array and returns an iterator
+   *    that moves them out. The items after the range are moved down to close the gap.
+   *    The removed items are moved into a buffer of their own, so the array can be
+   *    used while they are consumed.
+   *
+   * @param first: The index of the first item to remove
+   * @param last:  The index after the last item to remove
+   * @return:      An iterator that yields the removed items
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [1, 2, 3, 4, 5]
+   *
+   * int sum = ints.drain(1, 3).sum();
+   *
+   * // sum is 5
+   * // ints is: [1, 4, 5]
+   * ```
+   */
+  [[nodiscard]] IntoIter drain(size_t first, size_t last) {
+    last = last < this->num_elements ? last : this->num_elements;
+    first = first < last ? first : last;
+
+    std::shared_ptr<T[]> buffer(new T[last - first]);
+    std::move(this->data + first, this->data + last, buffer.get());
+    std::move(this->data + last, this->data + this->num_elements, this->data + first);
+    this->num_elements -= last - first;
+    return IntoIter(std::move(buffer), 0U, last - first);
+  }
+
+  /**
+   * Summary:
+   *    Returns an iterator that yields mutable references to the items.
+   *    It's only available on a non const array, so that's the way to
+   *    state that a pipeline writes to the array.
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...;
+   *
+   * ints.iter_mut()
+   *      .filter([](const int &v) { return v < 0; })
+   *      .for_each([](int &v) { v = 0; });
+   * ```
+   */
+  [[nodiscard]] ArrayIterator iter_mut() noexcept {
+    return ArrayIterator(*this);
+  }
+
+  /**
+   * Summary:
+   *    Calls `func` with a mutable reference to every item, in order
+   */
+  template<typename F>
+  void for_each_mut(F func) {
+    T *items = this->data;
+    for (size_t i = 0U; i != this->num_elements; ++i) {
+      func(items[i]);
+    }
+  }
+
+  /**
+   * Summary:
+   *    Replaces every item with `func(item)`. That's a plain loop over
+   *    the memory of the array, which the compiler can vectorise for
+   *    simple functions, and no new array is allocated.
+   *
+   * @example:
+   * ```
+   * Array<float> prices = ...;
+   *
+   * prices.transform_in_place([](const float &p) { return p * 1.24f; });
+   * ```
+   */
+  template<typename F>
+  void transform_in_place(F func) {
+    T *items = this->data;
+    for (size_t i = 0U; i != this->num_elements; ++i) {
+      items[i] = func(static_cast<const T &>(items[i]));
+    }
+  }
+
+  /**
+   * Summary:
+   *    Keeps only the items that match the predicate, in their order,
+   *    and shrinks the array accordingly. The memory is not reallocated.
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [1, 2, 3, 4]
+   *
+   * ints.retain([](const int &v) { return v % 2 == 0; });
+   *
+   * // ints is: [2, 4]
+   * ```
+   */
+  template<typename Predicate>
+  void retain(Predicate p) {
+    ASSERT_RETURNS_BOOL(Predicate, const T &);
+
+    size_t kept = 0U;
+    for (size_t i = 0U; i != this->num_elements; ++i) {
+      if (p(static_cast<const T &>(this->data[i]))) {
+        if (kept != i) {
+          this->data[kept] = std::move(this->data[i]);
+        }
+        ++kept;
+      }
+    }
+    this->num_elements = kept;
+  }
+
+  /**
+   * Summary:
+   *    Removes consecutive equal items, so a sorted array
+   *    ends up with every item once. The memory is not reallocated.
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [1, 1, 2, 1, 1]
+   *
+   * ints.dedup();
+   *
+   * // ints is: [1, 2, 1]
+   * ```
+   */
+  void dedup() {
+    if (this->num_elements == 0U) {
+      return;
+    }
+
+    size_t kept = 1U;
+    for (size_t i = 1U; i != this->num_elements; ++i) {
+      if (!(this->data[i] == this->data[kept - 1U])) {
+        if (kept != i) {
+          this->data[kept] = std::move(this->data[i]);
+        }
+        ++kept;
+      }
+    }
+    this->num_elements = kept;
+  }
+
+  /**
+   * Summary:
+   *    Assigns `value` to every item. For byte sized items
+   *    that's a `memset`.
+   */
+  void fill(const T &value) {
+    std::fill(this->data, this->data + this->num_elements, value);
+  }
+
+  /**
+   * Summary:
+   *    Finds the first item that is not less than `value` in a sorted array.
+   *    The search is branchless: every step picks the half to keep with a
+   *    conditional move instead of a jump, so there are no mispredictions,
+   *    and the two possible probes of the next step are prefetched.
+   *
+   * @param value: The value to search for
+   * @param cmp:   The less than comparison the array is sorted by
+   * @return:      An iterator that starts at the found item and runs to the end of the array
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [1, 3, 3, 5]
+   *
+   * auto it = ints.lower_bound(3);
+   *
+   * // it yields: [3, 3, 5]
+   * ```
+   */
+  template<typename U, typename Compare = std::less<>>
+  [[nodiscard]] ArrayIterator lower_bound(const U &value, Compare cmp = Compare{}) const {
+    const size_t index = partition_point([&value, &cmp](const T &item) { return cmp(item, value); });
+    return ArrayIterator(*this, index, this->num_elements);
+  }
+
+  /**
+   * Summary:
+   *    Finds the first item that is greater than `value` in a sorted array.
+   *    See `lower_bound`.
+   *
+   * @return: An iterator that starts at the found item and runs to the end of the array
+   */
+  template<typename U, typename Compare = std::less<>>
+  [[nodiscard]] ArrayIterator upper_bound(const U &value, Compare cmp = Compare{}) const {
+    const size_t index = partition_point([&value, &cmp](const T &item) { return !cmp(value, item); });
+    return ArrayIterator(*this, index, this->num_elements);
+  }
+
+  /**
+   * Summary:
+   *    Finds the items that are equal to `value` in a sorted array
+   *
+   * @return: An iterator over the equal items. It's empty if there are none
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [1, 3, 3, 5]
+   *
+   * size_t threes = ints.equal_range(3).count();
+   *
+   * // threes is 2
+   * ```
+   */
+  template<typename U, typename Compare = std::less<>>
+  [[nodiscard]] ArrayIterator equal_range(const U &value, Compare cmp = Compare{}) const {
+    const size_t first = lower_bound(value, cmp).cursor;
+    const size_t last = upper_bound(value, cmp).cursor;
+    return ArrayIterator(*this, first, last);
+  }
+
+  /**
+   * Summary:
+   *    Looks up `value` in a sorted array
+   *
+   * @return: An iterator that starts at an item equal to `value` and runs to the end
+   *          of the array, or an empty iterator if there is no such item
+   *
+   * @example:
+   * ```
+   * Array<int> ids = ...; // sorted
+   *
+   * if (auto id = ids.binary_search(42).next()) {
+   *     // found
+   * }
+   * ```
+   */
+  template<typename U, typename Compare = std::less<>>
+  [[nodiscard]] ArrayIterator binary_search(const U &value, Compare cmp = Compare{}) const {
+    ArrayIterator res = lower_bound(value, cmp);
+    if (res.cursor == this->num_elements || cmp(value, this->data[res.cursor])) {
+      res.cursor = res.limit;
+    }
+    return res;
+  }
+
 private:
+  /**
+   * Summary:
+   *    Returns the index of the first item for which `pred` is false,
+   *    given that it's true for a prefix of the array and false after it
+   */
+  template<typename Predicate>
+  size_t partition_point(Predicate pred) const {
+    if (this->num_elements == 0U) {
+      return 0U;
+    }
+
+    const T *base = this->data;
+    size_t n = this->num_elements;
+    while (n > 1U) {
+      const size_t half = n / 2U;
+      internal::prefetch(base + half / 2U);
+      internal::prefetch(base + half + half / 2U);
+      base = pred(base[half]) ? base + half : base;
+      n -= half;
+    }
+    return static_cast<size_t>(base - this->data) + static_cast<size_t>(pred(*base));
+  }
+
+  template<typename Expr>
+  void assign(const Expr &expr) {
+    T *out = this->data;
+    for (size_t i = 0U; i != this->num_elements; ++i) {
+      out[i] = static_cast<T>(expr[i]);
+    }
+  }
+
   constexpr void copy(const Array<T> &rhs) {
     if constexpr (std::is_trivially_copy_assignable_v<T>) {
       memcpy(this->data, rhs.data, rhs.num_elements * sizeof(T));
@@ -112,4 +604,32 @@ private:
   size_t num_elements;
 };
 
+/**
+ * Summary:
+ *      Looks up the items of `table` at the indexes yielded by `indices`,
+ *      prefetching the item `distance` lookups ahead so that the random
+ *      accesses to the table overlap instead of stalling one after another.
+ *      The iterator yields references to the items of the table, which
+ *      must outlive it.
+ *
+ * @param table:    The table to look up
+ * @param indices:  An iterator that yields indexes into the table
+ * @param distance: How many lookups ahead to prefetch
+ * @return:         An iterator over the looked up items
+ *
+ * @example:
+ * ```
+ * Array<double> prices = ...;
+ * Array<size_t> ids = ...;
+ *
+ * double total = gather(prices, ids.iter()).sum();
+ * ```
+ */
+template<typename T, typename IndexIterator>
+auto gather(const Array<T> &table, IndexIterator indices, size_t distance = 16U) {
+  return indices
+      .prefetch(distance, [&table](const size_t &index) { return &table[index]; })
+      .map([&table](const size_t &index) { return std::ref(table[index]); });
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,240 @@
+#ifndef ITERATOR_DATA_STRUCTURES_ARRAY_EXPR_H
+#define ITERATOR_DATA_STRUCTURES_ARRAY_EXPR_H
+
+#include <functional>
+#include <type_traits>
+#include "array.h"
+
+namespace internal {
+/**
+ * Summary:
+ *      The leaf of an expression that reads the items of an `Array`
+ */
+template<typename T>
+struct ArrayOperand {
+  static constexpr bool is_scalar = false;
+
+  [[nodiscard]] size_t len() const noexcept { return this->num_elements; }
+
+  const T &operator[](size_t index) const { return this->data[index]; }
+
+  const T *data;
+  size_t num_elements;
+};
+
+/**
+ * Summary:
+ *      The leaf of an expression that yields the same value for every index
+ */
+template<typename T>
+struct ScalarOperand {
+  static constexpr bool is_scalar = true;
+
+  T operator[](size_t) const { return this->value; }
+
+  T value;
+};
+
+template<typename T>
+struct is_array : std::false_type {};
+
+template<typename T>
+struct is_array<Array<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_array_operand_v = is_array<T>::value || is_array_expr_v<T>;
+
+/**
+ * Summary:
+ *      Enables the element wise operators when at least one of the operands
+ *      is an `Array` or an expression and the other one is also one or an arithmetic value
+ */
+template<typename L, typename R>
+using enable_if_array_operands_t = std::enable_if_t<
+    (is_array_operand_v<L> && (is_array_operand_v<R> || std::is_arithmetic_v<R>))
+        || (std::is_arithmetic_v<L> && is_array_operand_v<R>)>;
+
+template<typename T>
+auto as_operand(const T &operand) {
+  if constexpr (is_array<T>::value) {
+    using ItemType = std::remove_reference_t<decltype(operand[0U])>;
+    return ArrayOperand<ItemType>{operand.len() != 0U ? &operand[0U] : nullptr, operand.len()};
+  } else if constexpr (is_array_expr_v<T>) {
+    return operand;
+  } else {
+    return ScalarOperand<T>{operand};
+  }
+}
+}
+
+template<typename Expr>
+struct ArrayExprIterator;
+
+/**
+ * Summary:
+ *      A lazy element wise expression over `Array`s, built by the arithmetic
+ *      operators below. Nothing is computed until the expression is assigned to
+ *      an `Array` (or converted to one), which evaluates the whole expression in one
+ *      loop without any intermediate `Array`s. Since each item only depends on the
+ *      items at the same index, that loop is easy for the compiler to vectorise.
+ *      The expression keeps pointers to the arrays, so it must not outlive them.
+ *      If the arrays have different lengths, the expression has the shortest one.
+ *
+ * @tparam L:  The type of the left operand
+ * @tparam R:  The type of the right operand
+ * @tparam Op: The type of the binary operation
+ *
+ * @example:
+ * ```
+ * Array<double> a = ..., b = ..., c = ...;
+ *
+ * Array<double> res = a * b + c;     // One loop, no temporaries
+ * res = res * 0.5 - 1.0;             // Also one loop, in place
+ *
+ * double total = (a * b).iter().sum();
+ * ```
+ */
+template<typename L, typename R, typename Op>
+struct ArrayExpr {
+  static constexpr bool is_array_expr = true;
+  static constexpr bool is_scalar = false;
+
+  ArrayExpr(L lhs, R rhs, Op op) : lhs{lhs}, rhs{rhs}, op{op} {}
+
+  [[nodiscard]] size_t len() const noexcept {
+    if constexpr (L::is_scalar) {
+      return this->rhs.len();
+    } else if constexpr (R::is_scalar) {
+      return this->lhs.len();
+    } else {
+      return this->lhs.len() < this->rhs.len() ? this->lhs.len() : this->rhs.len();
+    }
+  }
+
+  auto operator[](size_t index) const { return this->op(this->lhs[index], this->rhs[index]); }
+
+  /**
+   * Summary:
+   *    Evaluates the expression into a new `Array`
+   */
+  [[nodiscard]] auto eval() const {
+    return Array<std::decay_t<decltype((*this)[0U])>>(*this);
+  }
+
+  /**
+   * Summary:
+   *    Returns a random access iterator over the items of the expression,
+   *    to feed it into a pipeline without evaluating it first
+   */
+  [[nodiscard]] ArrayExprIterator<ArrayExpr<L, R, Op>> iter() const {
+    return ArrayExprIterator<ArrayExpr<L, R, Op>>(*this);
+  }
+
+  L lhs;
+  R rhs;
+  Op op;
+};
+
+/**
+ * Summary:
+ *      A random access iterator over the items of an `ArrayExpr`.
+ *      To get an iterator of this type, call `iter` on an expression.
+ */
+template<typename Expr>
+struct ArrayExprIterator : public Iterator<std::decay_t<decltype(std::declval<const Expr &>()[0U])>,
+                                           ArrayExprIterator<Expr>> {
+  using ItemType = std::decay_t<decltype(std::declval<const Expr &>()[0U])>;
+
+  explicit ArrayExprIterator(Expr expr) : expr{expr}, cursor{0U}, limit{expr.len()} {}
+
+  std::optional<ItemType> next() {
+    if (this->cursor < this->limit) {
+      return std::make_optional(this->expr[this->cursor++]);
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<ItemType> next_back() {
+    if (this->cursor < this->limit) {
+      return std::make_optional(this->expr[--this->limit]);
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+  ItemType operator[](size_t index) const { return this->expr[this->cursor + index]; }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  size_t advance_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->cursor += advanced;
+    return advanced;
+  }
+
+  size_t advance_back_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->limit -= advanced;
+    return advanced;
+  }
+
+  size_t count() {
+    return advance_by(len());
+  }
+
+  Expr expr;
+  size_t cursor;
+  size_t limit;
+};
+
+namespace internal {
+template<typename L, typename R, typename Op>
+auto make_array_expr(const L &lhs, const R &rhs, Op op) {
+  using LhsOperand = decltype(as_operand(lhs));
+  using RhsOperand = decltype(as_operand(rhs));
+  return ArrayExpr<LhsOperand, RhsOperand, Op>(as_operand(lhs), as_operand(rhs), op);
+}
+}
+
+template<typename L, typename R, typename = internal::enable_if_array_operands_t<L, R>>
+auto operator+(const L &lhs, const R &rhs) {
+  return internal::make_array_expr(lhs, rhs, std::plus<>{});
+}
+
+template<typename L, typename R, typename = internal::enable_if_array_operands_t<L, R>>
+auto operator-(const L &lhs, const R &rhs) {
+  return internal::make_array_expr(lhs, rhs, std::minus<>{});
+}
+
+template<typename L, typename R, typename = internal::enable_if_array_operands_t<L, R>>
+auto operator*(const L &lhs, const R &rhs) {
+  return internal::make_array_expr(lhs, rhs, std::multiplies<>{});
+}
+
+template<typename L, typename R, typename = internal::enable_if_array_operands_t<L, R>>
+auto operator/(const L &lhs, const R &rhs) {
+  return internal::make_array_expr(lhs, rhs, std::divides<>{});
+}
+
+/**
+ * Summary:
+ *      Creates a lazy expression that applies a binary function to the items
+ *      of two operands at the same index, for operations that have no operator
+ *      (e.g. `std::max` or a clamp)
+ *
+ * @example:
+ * ```
+ * Array<float> relu = zip_with(x, 0.0f, [](float a, float b) { return a > b ? a : b; });
+ * ```
+ */
+template<typename L, typename R, typename F, typename = internal::enable_if_array_operands_t<L, R>>
+auto zip_with(const L &lhs, const R &rhs, F func) {
+  return internal::make_array_expr(lhs, rhs, func);
+}
+
+#endif //ITERATOR_DATA_STRUCTURES_ARRAY_EXPR_H
@@ -0,0 +1,336 @@
+#ifndef ITERATOR_DATA_STRUCTURES_CONCURRENT_HASH_SET_H
+#define ITERATOR_DATA_STRUCTURES_CONCURRENT_HASH_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "array.h"
+
+/**
+ * Summary:
+ *      A hash set that many threads can insert into at the same time.
+ *      The items are split into shards by their hash, and each shard is an
+ *      open addressing (linear probing) table behind its own mutex, so threads
+ *      only wait for each other when they hit the same shard. With the default
+ *      64 shards that is rare. The shards are cache line aligned so that their
+ *      locks don't share lines.
+ *      Besides membership, every item remembers the smallest index it was inserted
+ *      with (see `insert_at`), which is how `par_unique` keeps the first occurrences
+ *      in order.
+ *      `iter` must not run while other threads insert.
+ *
+ * @tparam T:    The type of the items
+ * @tparam Hash: The type of the hash functor
+ *
+ * @example:
+ * ```
+ * ConcurrentHashSet<int> seen{};
+ *
+ * // On any number of threads
+ * if (seen.insert(id)) {
+ *     // First time anyone saw id
+ * }
+ * ```
+ */
+template<typename T, typename Hash = std::hash<T>>
+struct ConcurrentHashSet {
+  static constexpr size_t DEFAULT_SHARDS = 64U;
+
+  /**
+   * Summary:
+   *    Creates an empty set
+   *
+   * @param num_shards: The number of shards, rounded up to a power of two
+   */
+  explicit ConcurrentHashSet(size_t num_shards = DEFAULT_SHARDS) : shards{}, shard_bits{0U}, hash{} {
+    while ((size_t{1U} << this->shard_bits) < num_shards) {
+      ++this->shard_bits;
+    }
+    this->shards.reset(new Shard[size_t{1U} << this->shard_bits]);
+  }
+
+  ConcurrentHashSet(const ConcurrentHashSet &) = delete;
+  ConcurrentHashSet &operator=(const ConcurrentHashSet &) = delete;
+
+  /**
+   * Summary:
+   *    Inserts an item and returns true if it wasn't in the set
+   */
+  bool insert(const T &value) {
+    return insert_at(value, NO_INDEX);
+  }
+
+  /**
+   * Summary:
+   *    Inserts an item that was found at `index` of some sequence. If the item
+   *    is already in the set, it keeps the smaller of the two indexes.
+   *
+   * @return: true if `index` is now the smallest index of the item
+   */
+  bool insert_at(const T &value, size_t index) {
+    const size_t h = mix(this->hash(value));
+    Shard &shard = shard_of(h);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    size_t slot = shard.probe(value, h);
+    const size_t entry = shard.slots[slot];
+    if (entry != EMPTY) {
+      if (index < shard.firsts[entry]) {
+        shard.firsts[entry] = index;
+        return true;
+      }
+      return false;
+    }
+
+    if ((shard.values.size() + 1U) * 2U > shard.slots.size()) {
+      shard.grow();
+      slot = shard.probe(value, h);
+    }
+    shard.slots[slot] = shard.values.size();
+    shard.values.push_back(value);
+    shard.hashes.push_back(h);
+    shard.firsts.push_back(index);
+    return true;
+  }
+
+  [[nodiscard]] bool contains(const T &value) const {
+    const size_t h = mix(this->hash(value));
+    const Shard &shard = shard_of(h);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.slots[shard.probe(value, h)] != EMPTY;
+  }
+
+  /**
+   * Summary:
+   *    Returns the smallest index an item was inserted with by `insert_at`,
+   *    or nothing if it's not in the set or was only added by `insert`
+   */
+  [[nodiscard]] std::optional<size_t> first_index(const T &value) const {
+    const size_t h = mix(this->hash(value));
+    const Shard &shard = shard_of(h);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const size_t entry = shard.slots[shard.probe(value, h)];
+    if (entry == EMPTY || shard.firsts[entry] == NO_INDEX) {
+      return std::nullopt;
+    }
+    return std::make_optional(shard.firsts[entry]);
+  }
+
+  [[nodiscard]] size_t len() const {
+    size_t res = 0U;
+    for (size_t i = 0U; i != num_shards(); ++i) {
+      std::lock_guard<std::mutex> lock(this->shards[i].mutex);
+      res += this->shards[i].values.size();
+    }
+    return res;
+  }
+
+  [[nodiscard]] size_t num_shards() const noexcept { return size_t{1U} << this->shard_bits; }
+
+  struct ConcurrentHashSetIterator;
+
+  /**
+   * Summary:
+   *    Returns an iterator over the items, shard by shard
+   */
+  [[nodiscard]] ConcurrentHashSetIterator iter() const {
+    return ConcurrentHashSetIterator(this);
+  }
+
+  /**
+   * Summary:
+   *      An iterator over the items of a `ConcurrentHashSet`, in no particular order.
+   *      To get an iterator of this type, call `iter` on a set.
+   */
+  struct ConcurrentHashSetIterator : public Iterator<std::reference_wrapper<const T>, ConcurrentHashSetIterator> {
+    using ItemType = std::reference_wrapper<const T>;
+
+    explicit ConcurrentHashSetIterator(const ConcurrentHashSet<T, Hash> *set) : set{set}, shard{0U}, entry{0U} {}
+
+    std::optional<ItemType> next() {
+      for (; this->shard != this->set->num_shards(); ++this->shard, this->entry = 0U) {
+        const auto &values = this->set->shards[this->shard].values;
+        if (this->entry != values.size()) {
+          return std::make_optional(std::cref(values[this->entry++]));
+        }
+      }
+      return std::nullopt;
+    }
+
+    const ConcurrentHashSet<T, Hash> *set;
+    size_t shard;
+    size_t entry;
+  };
+
+private:
+  static constexpr size_t EMPTY = SIZE_MAX;
+  static constexpr size_t NO_INDEX = SIZE_MAX;
+
+  struct alignas(64) Shard {
+    Shard() : mutex{}, slots(16U, EMPTY), values{}, hashes{}, firsts{} {}
+
+    [[nodiscard]] size_t probe(const T &value, size_t h) const {
+      const size_t mask = this->slots.size() - 1U;
+      for (size_t slot = h & mask;; slot = (slot + 1U) & mask) {
+        const size_t entry = this->slots[slot];
+        if (entry == EMPTY || (this->hashes[entry] == h && this->values[entry] == value)) {
+          return slot;
+        }
+      }
+    }
+
+    void grow() {
+      this->slots.assign(this->slots.size() * 2U, EMPTY);
+      const size_t mask = this->slots.size() - 1U;
+      for (size_t entry = 0U; entry != this->values.size(); ++entry) {
+        size_t slot = this->hashes[entry] & mask;
+        while (this->slots[slot] != EMPTY) {
+          slot = (slot + 1U) & mask;
+        }
+        this->slots[slot] = entry;
+      }
+    }
+
+    mutable std::mutex mutex;
+    std::vector<size_t> slots;
+    std::vector<T> values;
+    std::vector<size_t> hashes;
+    std::vector<size_t> firsts;
+  };
+
+  /**
+   * Summary:
+   *    Spreads the bits of the hash, since `std::hash` of an integer is
+   *    the integer itself and the shard is picked by the high bits
+   */
+  static size_t mix(size_t h) noexcept {
+    auto x = static_cast<uint64_t>(h);
+    x ^= x >> 33U;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33U;
+    return static_cast<size_t>(x);
+  }
+
+  Shard &shard_of(size_t h) const noexcept {
+    return this->shards[this->shard_bits == 0U ? 0U : static_cast<uint64_t>(h) >> (64U - this->shard_bits)];
+  }
+
+  std::unique_ptr<Shard[]> shards;
+  size_t shard_bits;
+  Hash hash;
+};
+
+/**
+ * Summary:
+ *      The order of the items `par_unique` returns
+ */
+enum class UniqueOrder {
+  // The first occurrence of every item, in the order of the input, like `unique`
+  FirstOccurrence,
+  // The unique items in whatever order the threads found them, which is faster
+  Unordered
+};
+
+namespace internal {
+/**
+ * Summary:
+ *      Splits `[0, len)` into one contiguous chunk per thread and calls
+ *      `func(chunk, first, last)` for each one on its own thread. The calling
+ *      thread takes the first chunk.
+ */
+template<typename F>
+void parallel_chunks(size_t len, size_t num_threads, F func) {
+  std::vector<std::thread> threads{};
+  threads.reserve(num_threads - 1U);
+  for (size_t chunk = 1U; chunk < num_threads; ++chunk) {
+    threads.emplace_back([&func, chunk, len, num_threads]() {
+      func(chunk, len * chunk / num_threads, len * (chunk + 1U) / num_threads);
+    });
+  }
+  func(0U, 0U, len / num_threads);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}
+
+/**
+ * Summary:
+ *      Collects the unique items of a random access pipeline using several threads,
+ *      which share a `ConcurrentHashSet`. Each thread walks a contiguous chunk of
+ *      the pipeline and reads the items by index, so the pipeline is evaluated in
+ *      parallel too.
+ *      With `UniqueOrder::FirstOccurrence` the result is the same as `unique().collect<Array>()`.
+ *      That needs a second, much smaller pass over the items each thread saw first, to drop
+ *      the ones an earlier chunk also has. `UniqueOrder::Unordered` skips it.
+ *      Small inputs are handled by fewer threads, down to one.
+ *
+ * @param iter:        A random access iterator, e.g. `Array::iter` followed by `map`s
+ * @param order:       The order of the result
+ * @param num_threads: The maximum number of threads. 0 means one per hardware thread
+ * @return:            An `Array` of the unique items
+ *
+ * @example:
+ * ```
+ * Array<std::string> urls = ...;
+ *
+ * auto hosts = par_unique(urls.iter().map(host_of));
+ * ```
+ */
+template<typename IteratorType>
+auto par_unique(const IteratorType &iter, UniqueOrder order = UniqueOrder::FirstOccurrence, size_t num_threads = 0U) {
+  static_assert(internal::is_random_access_v<IteratorType>, "par_unique needs a random access iterator");
+
+  using Value = internal::strip_ref_wrapper_t<internal::item_type<IteratorType>>;
+  // Below that, the threads cost more than they save
+  constexpr size_t MIN_ITEMS_PER_THREAD = 4096U;
+
+  const size_t len = iter.len();
+  if (num_threads == 0U) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::max<size_t>(1U, std::min(num_threads, len / MIN_ITEMS_PER_THREAD));
+
+  ConcurrentHashSet<Value> set{};
+  std::vector<std::vector<std::pair<size_t, Value>>> found(num_threads);
+  internal::parallel_chunks(len, num_threads, [&](size_t chunk, size_t first, size_t last) {
+    auto &res = found[chunk];
+    for (size_t i = first; i != last; ++i) {
+      Value v = iter[i];
+      const bool is_new = order == UniqueOrder::FirstOccurrence ? set.insert_at(v, i) : set.insert(v);
+      if (is_new) {
+        res.emplace_back(i, std::move(v));
+      }
+    }
+  });
+
+  if (order == UniqueOrder::FirstOccurrence) {
+    // An item was kept by every chunk that saw it before the chunks on its left did.
+    // Only the one with the smallest index is the first occurrence.
+    internal::parallel_chunks(num_threads, num_threads, [&](size_t chunk, size_t, size_t) {
+      auto &res = found[chunk];
+      res.erase(std::remove_if(res.begin(), res.end(), [&set](const std::pair<size_t, Value> &item) {
+        return set.first_index(item.second) != item.first;
+      }), res.end());
+    });
+  }
+
+  size_t total = 0U;
+  for (const auto &res : found) {
+    total += res.size();
+  }
+  Array<Value> unique(total);
+  size_t index = 0U;
+  for (auto &res : found) {
+    for (auto &item : res) {
+      unique[index++] = std::move(item.second);
+    }
+  }
+  return unique;
+}
+
+#endif //ITERATOR_DATA_STRUCTURES_CONCURRENT_HASH_SET_H
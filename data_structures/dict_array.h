@@ -0,0 +1,212 @@
+#ifndef ITERATOR_DATA_STRUCTURES_DICT_ARRAY_H
+#define ITERATOR_DATA_STRUCTURES_DICT_ARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "array.h"
+
+/**
+ * Summary:
+ *      A dictionary encoded array of strings.
+ *      Every distinct string is stored once in a dictionary (in order of
+ *      first occurrence) and the array itself is an `Array<uint32_t>` of
+ *      codes into that dictionary.
+ *      `iter` yields `std::string_view`s into the dictionary and `codes`
+ *      yields the codes themselves. `filter`, `unique` and `counts` evaluate
+ *      once per dictionary entry and then only touch the codes, so they never
+ *      compare or hash a string per item.
+ *      The iterators point into the array, which must outlive them. Calling
+ *      `iter`, `codes`, `filter` or `unique` on a temporary doesn't compile.
+ *
+ * @example:
+ * ```
+ * Array<std::string> countries(4);
+ * countries[0] = "GR";
+ * countries[1] = "US";
+ * countries[2] = "GR";
+ * countries[3] = "DE";
+ *
+ * DictArray dict(countries);
+ *
+ * // dict.dictionary_len() is 3
+ * // dict.codes() yields: [0, 1, 0, 2]
+ *
+ * auto greek = dict
+ *      .filter([](std::string_view s) { return s == "GR"; })
+ *      .count();
+ *
+ * // greek is 2
+ * ```
+ */
+struct DictArray {
+  using Code = uint32_t;
+
+  DictArray() : entries{}, encoded{}, sorted{} {}
+
+  explicit DictArray(const Array<std::string> &strings) : entries{}, encoded{strings.len()}, sorted{} {
+    std::unordered_map<std::string_view, Code> index{};
+    for (size_t i = 0U; i != strings.len(); ++i) {
+      auto[it, _] = index.emplace(strings[i], static_cast<Code>(index.size()));
+      this->encoded[i] = it->second;
+    }
+
+    this->entries.reserve(index.size());
+    for (const auto &[str, code] : index) {
+      this->entries[code] = std::string(str);
+    }
+
+    this->sorted.reserve(this->entries.len());
+    for (size_t i = 0U; i != this->sorted.len(); ++i) {
+      this->sorted[i] = static_cast<Code>(i);
+    }
+    std::sort(&this->sorted[0], &this->sorted[0] + this->sorted.len(), ByValue{this});
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->encoded.len(); }
+
+  [[nodiscard]] size_t dictionary_len() const noexcept { return this->entries.len(); }
+
+  [[nodiscard]] std::string_view decode(Code code) const { return this->entries[code]; }
+
+  std::string_view operator[](size_t index) const { return decode(this->encoded[index]); }
+
+  /**
+   * Summary:
+   *    Returns the code of the given string if it is in the dictionary.
+   *    It's a binary search over the codes sorted by their strings.
+   */
+  [[nodiscard]] std::optional<Code> code_of(std::string_view str) const {
+    auto code = this->sorted.binary_search(str, ByValue{this}).next();
+    if (code.has_value()) {
+      return std::make_optional(code->get());
+    }
+    return std::nullopt;
+  }
+
+  struct DictArrayIterator : public Iterator<std::string_view, DictArrayIterator> {
+    using ItemType = std::string_view;
+
+    explicit DictArrayIterator(const DictArray &cont) : cont{cont}, codes{cont.encoded.iter()} {}
+
+    std::optional<ItemType> next() {
+      auto code = this->codes.next();
+      if (code.has_value()) {
+        return std::make_optional(this->cont.get().decode(*code));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    size_t advance_by(size_t n) {
+      return this->codes.advance_by(n);
+    }
+
+    std::reference_wrapper<const DictArray> cont;
+    Array<Code>::ArrayIterator codes;
+  };
+
+  [[nodiscard]] DictArrayIterator iter() const & noexcept {
+    return DictArrayIterator(*this);
+  }
+
+  // The iterators point into the array, so they can't be taken from a temporary
+  DictArrayIterator iter() const && = delete;
+
+  /**
+   * Summary:
+   *    Returns an iterator over the codes of the array
+   */
+  [[nodiscard]] Array<Code>::ArrayIterator codes() const & noexcept {
+    return this->encoded.iter();
+  }
+
+  Array<Code>::ArrayIterator codes() const && = delete;
+
+  /**
+   * Summary:
+   *    Evaluates the predicate once per dictionary entry
+   *
+   * @return: A mask indexed by code which is true for the entries that match the predicate
+   */
+  template<typename Predicate>
+  Array<bool> matching(Predicate p) const {
+    ASSERT_RETURNS_BOOL(Predicate, std::string_view);
+
+    Array<bool> mask(this->entries.len());
+    for (size_t i = 0U; i != this->entries.len(); ++i) {
+      mask[i] = p(std::string_view(this->entries[i]));
+    }
+    return mask;
+  }
+
+  /**
+   * Summary:
+   *    Yields the strings that match the given predicate. The predicate
+   *    is evaluated once per dictionary entry and the items are
+   *    filtered by their code.
+   */
+  template<typename Predicate>
+  auto filter(Predicate p) const & {
+    // Shared, so that copies of the iterator don't copy the mask
+    auto mask = std::make_shared<const Array<bool>>(matching(p));
+    return codes()
+        .filter([mask](const Code &code) { return (*mask)[code]; })
+        .map([&entries = this->entries](const Code &code) { return std::string_view(entries[code]); });
+  }
+
+  template<typename Predicate>
+  auto filter(Predicate p) const && = delete;
+
+  /**
+   * Summary:
+   *    Yields each distinct string once, in order of first occurrence.
+   *    Since that's the order of the dictionary, no hashing is needed.
+   */
+  [[nodiscard]] auto unique() const & {
+    return this->entries.iter().map([](const std::string &s) { return std::string_view(s); });
+  }
+
+  void unique() const && = delete;
+
+  /**
+   * Summary:
+   *    Groups the items by value
+   *
+   * @return: The number of occurrences of each dictionary entry, indexed by code
+   */
+  [[nodiscard]] Array<size_t> counts() const {
+    Array<size_t> res(this->entries.len());
+    memset(&res[0], 0, res.len() * sizeof(size_t));
+    for (size_t i = 0U; i != this->encoded.len(); ++i) {
+      ++res[this->encoded[i]];
+    }
+    return res;
+  }
+
+private:
+  /**
+   * Summary:
+   *    Orders codes by their strings, and compares them with plain strings too
+   */
+  struct ByValue {
+    template<typename L, typename R>
+    bool operator()(const L &lhs, const R &rhs) const { return key(lhs) < key(rhs); }
+
+    [[nodiscard]] std::string_view key(Code code) const { return this->dict->decode(code); }
+
+    [[nodiscard]] static std::string_view key(std::string_view str) { return str; }
+
+    const DictArray *dict;
+  };
+
+  Array<std::string> entries;
+  Array<Code> encoded;
+  // The codes of the dictionary sorted by their strings, for `code_of`
+  Array<Code> sorted;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_DICT_ARRAY_H
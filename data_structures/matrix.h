@@ -0,0 +1,420 @@
+#ifndef ITERATOR_DATA_STRUCTURES_MATRIX_H
+#define ITERATOR_DATA_STRUCTURES_MATRIX_H
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <numeric>
+#include "../iter_from.h"
+
+/**
+ * Summary:
+ *      A dense row major matrix. Every row starts on a 64 byte boundary,
+ *      so the rows are padded up to `stride()` items when the row size is not
+ *      a multiple of a cache line. When the size of `T` doesn't divide 64, the
+ *      stride is a multiple of as many items as it takes to fill a whole
+ *      number of cache lines (e.g. 8 items of 24 bytes are 3 lines).
+ *      `rows` yields every row and `cols` every column as an iterator over references.
+ *      `tiles` splits the matrix into blocks that fit in the cache and yields them one
+ *      after another, which is what column wise reductions and transposes should walk
+ *      instead of whole columns.
+ *
+ * @tparam T: The type of the items
+ *
+ * @example:
+ * ```
+ * Matrix<int> m(2, 3);
+ * // m is:
+ * // [1, 2, 3]
+ * // [4, 5, 6]
+ *
+ * auto col_sums = m.cols()
+ *      .map([](StridedIterator<int> col) { return col.sum(); })
+ *      .collect<Array>();
+ *
+ * // col_sums is: [5, 7, 9]
+ *
+ * Matrix<int> t{};
+ * m.transpose_into(t);
+ *
+ * // t is:
+ * // [1, 4]
+ * // [2, 5]
+ * // [3, 6]
+ * ```
+ */
+template<typename T>
+struct Matrix {
+  static constexpr size_t ALIGNMENT = 64U;
+
+  /**
+   * Summary:
+   *    The number of items of a tile side that `transpose_into` uses
+   */
+  static constexpr size_t TRANSPOSE_BLOCK = ALIGNMENT / sizeof(T) > 8U ? ALIGNMENT / sizeof(T) : 8U;
+
+  Matrix() : data{nullptr}, height{0U}, width{0U}, pitch{0U} {}
+
+  Matrix(size_t rows, size_t cols) : data{nullptr}, height{rows}, width{cols}, pitch{padded(cols)} {
+    allocate();
+  }
+
+  Matrix(const Matrix<T> &rhs) : data{nullptr}, height{rhs.height}, width{rhs.width}, pitch{rhs.pitch} {
+    allocate();
+    std::copy(rhs.data, rhs.data + rhs.height * rhs.pitch, this->data);
+  }
+
+  Matrix(Matrix<T> &&rhs) noexcept {
+    move(rhs);
+  }
+
+  ~Matrix() { release(); }
+
+  Matrix &operator=(const Matrix<T> &rhs) {
+    if (this != &rhs) {
+      release();
+      this->height = rhs.height;
+      this->width = rhs.width;
+      this->pitch = rhs.pitch;
+      allocate();
+      std::copy(rhs.data, rhs.data + rhs.height * rhs.pitch, this->data);
+    }
+    return *this;
+  }
+
+  Matrix &operator=(Matrix<T> &&rhs) noexcept {
+    if (this != &rhs) {
+      release();
+      move(rhs);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_t num_rows() const noexcept { return this->height; }
+
+  [[nodiscard]] size_t num_cols() const noexcept { return this->width; }
+
+  /**
+   * Summary:
+   *    The distance in items between the starts of two consecutive rows
+   */
+  [[nodiscard]] size_t stride() const noexcept { return this->pitch; }
+
+  T &operator()(size_t row, size_t col) const { return this->data[row * this->pitch + col]; }
+
+  /**
+   * Summary:
+   *    Returns an iterator over the items of a row
+   */
+  [[nodiscard]] SliceIterator<T> row(size_t index) const {
+    return iter_from(this->data + index * this->pitch, this->width);
+  }
+
+  /**
+   * Summary:
+   *    Returns an iterator over the items of a column
+   */
+  [[nodiscard]] StridedIterator<T> col(size_t index) const {
+    return strided(this->data + index, this->height, this->pitch);
+  }
+
+  /**
+   * Summary:
+   *    A rectangular block of a matrix. The block is a view,
+   *    so it must not outlive the matrix.
+   */
+  struct Tile {
+    /**
+     * Summary:
+     *    Yields references to the items of a tile, row by row
+     */
+    struct TileIterator : public Iterator<std::reference_wrapper<T>, TileIterator> {
+      using ItemType = std::reference_wrapper<T>;
+
+      explicit TileIterator(const Tile &tile) : tile{tile}, cursor{0U} {}
+
+      std::optional<ItemType> next() {
+        if (len() != 0U) {
+          return std::make_optional(at(this->cursor++));
+        } else {
+          return std::nullopt;
+        }
+      }
+
+      [[nodiscard]] size_t len() const noexcept { return this->tile.height * this->tile.width - this->cursor; }
+
+      ItemType operator[](size_t index) const { return at(this->cursor + index); }
+
+      [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+        return std::make_pair(len(), std::make_optional(len()));
+      }
+
+      size_t advance_by(size_t n) {
+        const size_t advanced = n < len() ? n : len();
+        this->cursor += advanced;
+        return advanced;
+      }
+
+      size_t count() {
+        return advance_by(len());
+      }
+
+      Tile tile;
+      size_t cursor;
+
+    private:
+      [[nodiscard]] ItemType at(size_t index) const {
+        return std::ref(this->tile(index / this->tile.width, index % this->tile.width));
+      }
+    };
+
+    T &operator()(size_t row, size_t col) const { return this->first[row * this->stride + col]; }
+
+    /**
+     * Summary:
+     *    Returns an iterator over the items of a row of the tile
+     */
+    [[nodiscard]] SliceIterator<T> row(size_t index) const {
+      return iter_from(this->first + index * this->stride, this->width);
+    }
+
+    [[nodiscard]] TileIterator iter() const { return TileIterator(*this); }
+
+    T *first;
+    size_t stride;
+    // The position of the top left item in the matrix
+    size_t row_offset;
+    size_t col_offset;
+    size_t height;
+    size_t width;
+  };
+
+  struct RowsIterator : public Iterator<SliceIterator<T>, RowsIterator> {
+    using ItemType = SliceIterator<T>;
+
+    explicit RowsIterator(const Matrix<T> &cont) : cont{cont}, cursor{0U}, limit{cont.height} {}
+
+    std::optional<ItemType> next() {
+      if (this->cursor < this->limit) {
+        return std::make_optional(this->cont.get().row(this->cursor++));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    std::optional<ItemType> next_back() {
+      if (this->cursor < this->limit) {
+        return std::make_optional(this->cont.get().row(--this->limit));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+    ItemType operator[](size_t index) const { return this->cont.get().row(this->cursor + index); }
+
+    [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+      return std::make_pair(len(), std::make_optional(len()));
+    }
+
+    size_t advance_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->cursor += advanced;
+      return advanced;
+    }
+
+    size_t advance_back_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->limit -= advanced;
+      return advanced;
+    }
+
+    std::reference_wrapper<const Matrix<T>> cont;
+    size_t cursor;
+    size_t limit;
+  };
+
+  struct ColsIterator : public Iterator<StridedIterator<T>, ColsIterator> {
+    using ItemType = StridedIterator<T>;
+
+    explicit ColsIterator(const Matrix<T> &cont) : cont{cont}, cursor{0U}, limit{cont.width} {}
+
+    std::optional<ItemType> next() {
+      if (this->cursor < this->limit) {
+        return std::make_optional(this->cont.get().col(this->cursor++));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    std::optional<ItemType> next_back() {
+      if (this->cursor < this->limit) {
+        return std::make_optional(this->cont.get().col(--this->limit));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+    ItemType operator[](size_t index) const { return this->cont.get().col(this->cursor + index); }
+
+    [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+      return std::make_pair(len(), std::make_optional(len()));
+    }
+
+    size_t advance_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->cursor += advanced;
+      return advanced;
+    }
+
+    size_t advance_back_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->limit -= advanced;
+      return advanced;
+    }
+
+    std::reference_wrapper<const Matrix<T>> cont;
+    size_t cursor;
+    size_t limit;
+  };
+
+  /**
+   * Summary:
+   *    Yields the tiles of a matrix. The tiles are visited a row of tiles
+   *    at a time, so consecutive tiles share the same rows of the matrix.
+   *    The tiles of the last row and column are smaller if the size of
+   *    the matrix is not a multiple of the size of the tiles.
+   */
+  struct TilesIterator : public Iterator<Tile, TilesIterator> {
+    using ItemType = Tile;
+
+    TilesIterator(const Matrix<T> &cont, size_t tile_height, size_t tile_width)
+        : cont{cont}, tile_height{tile_height}, tile_width{tile_width},
+          tiles_per_row{(cont.width + tile_width - 1U) / tile_width}, cursor{0U},
+          limit{tiles_per_row * ((cont.height + tile_height - 1U) / tile_height)} {}
+
+    std::optional<ItemType> next() {
+      if (this->cursor < this->limit) {
+        return std::make_optional(tile(this->cursor++));
+      } else {
+        return std::nullopt;
+      }
+    }
+
+    [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+    ItemType operator[](size_t index) const { return tile(this->cursor + index); }
+
+    [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+      return std::make_pair(len(), std::make_optional(len()));
+    }
+
+    size_t advance_by(size_t n) {
+      const size_t advanced = n < len() ? n : len();
+      this->cursor += advanced;
+      return advanced;
+    }
+
+    std::reference_wrapper<const Matrix<T>> cont;
+    size_t tile_height;
+    size_t tile_width;
+    size_t tiles_per_row;
+    size_t cursor;
+    size_t limit;
+
+  private:
+    [[nodiscard]] Tile tile(size_t index) const {
+      const Matrix<T> &m = this->cont.get();
+      const size_t row = (index / this->tiles_per_row) * this->tile_height;
+      const size_t col = (index % this->tiles_per_row) * this->tile_width;
+      return Tile{&m(row, col), m.pitch, row, col,
+                  m.height - row < this->tile_height ? m.height - row : this->tile_height,
+                  m.width - col < this->tile_width ? m.width - col : this->tile_width};
+    }
+  };
+
+  [[nodiscard]] RowsIterator rows() const noexcept { return RowsIterator(*this); }
+
+  [[nodiscard]] ColsIterator cols() const noexcept { return ColsIterator(*this); }
+
+  /**
+   * Summary:
+   *    Returns an iterator over the `tile_height` x `tile_width` blocks of the matrix.
+   *    Both sizes must be non zero.
+   */
+  [[nodiscard]] TilesIterator tiles(size_t tile_height, size_t tile_width) const {
+    assert(tile_height != 0U && tile_width != 0U);
+    return TilesIterator(*this, tile_height, tile_width);
+  }
+
+  /**
+   * Summary:
+   *    Writes the transpose of the matrix into `dst`, which is resized if needed.
+   *    The copy goes tile by tile so that both the rows that are read and
+   *    the rows that are written stay in the cache.
+   */
+  void transpose_into(Matrix<T> &dst) const {
+    if (dst.height != this->width || dst.width != this->height) {
+      dst = Matrix<T>(this->width, this->height);
+    }
+
+    for (const Tile &tile : tiles(TRANSPOSE_BLOCK, TRANSPOSE_BLOCK)) {
+      for (size_t i = 0U; i != tile.height; ++i) {
+        for (size_t j = 0U; j != tile.width; ++j) {
+          dst(tile.col_offset + j, tile.row_offset + i) = tile(i, j);
+        }
+      }
+    }
+  }
+
+private:
+  /**
+   * Summary:
+   *    Rounds a row up to the smallest number of items that
+   *    is a multiple of both the item size and the alignment
+   */
+  static constexpr size_t padded(size_t cols) {
+    constexpr size_t items_per_block = std::lcm(sizeof(T), ALIGNMENT) / sizeof(T);
+    return (cols + items_per_block - 1U) / items_per_block * items_per_block;
+  }
+
+  void allocate() {
+    const size_t size = this->height * this->pitch;
+    if (size == 0U) {
+      this->data = nullptr;
+      return;
+    }
+    this->data = static_cast<T *>(::operator new[](size * sizeof(T), std::align_val_t{ALIGNMENT}));
+    std::uninitialized_value_construct_n(this->data, size);
+  }
+
+  void release() noexcept {
+    if (this->data) {
+      std::destroy_n(this->data, this->height * this->pitch);
+      ::operator delete[](this->data, std::align_val_t{ALIGNMENT});
+      this->data = nullptr;
+    }
+  }
+
+  constexpr void move(Matrix<T> &rhs) noexcept {
+    this->data = rhs.data;
+    this->height = rhs.height;
+    this->width = rhs.width;
+    this->pitch = rhs.pitch;
+    rhs.data = nullptr;
+    rhs.height = 0U;
+    rhs.width = 0U;
+    rhs.pitch = 0U;
+  }
+
+  T *data;
+  size_t height;
+  size_t width;
+  size_t pitch;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_MATRIX_H
@@ -0,0 +1,309 @@
+#ifndef ITERATOR_DATA_STRUCTURES_PACKED_ARRAY_H
+#define ITERATOR_DATA_STRUCTURES_PACKED_ARRAY_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "array.h"
+
+/**
+ * Summary:
+ *      An immutable array of integers that is stored compressed.
+ *      The values are split into blocks of `BLOCK_SIZE` items and each block
+ *      is stored using frame of reference encoding: we keep the minimum value
+ *      of the block and bit-pack the distances of every value from it using
+ *      as many bits as the largest distance needs.
+ *      With `Encoding::Delta`, the differences between consecutive values are
+ *      packed instead, which is what you want for sorted columns like ids or timestamps.
+ *      Iterating decodes one block at a time into a buffer that lives in the iterator.
+ *
+ * @tparam T: The integral type of the values
+ *
+ * @example:
+ * ```
+ * Array<uint64_t> timestamps(1000);
+ * for (size_t i = 0U; i != timestamps.len(); ++i) {
+ *      timestamps[i] = 1600000000U + i * 3;
+ * }
+ *
+ * PackedArray<uint64_t> packed(timestamps, PackedArray<uint64_t>::Encoding::Delta);
+ *
+ * // Each value now takes 2 bits instead of 64
+ * auto sum = packed.iter().skip(500).sum();
+ * ```
+ */
+template<typename T>
+struct PackedArray {
+  static_assert(std::is_integral_v<T>, "PackedArray can only store integral types");
+
+  static constexpr size_t BLOCK_SIZE = 128U;
+
+  enum class Encoding {
+    FrameOfReference,
+    Delta
+  };
+
+  PackedArray() : blocks{}, words{}, num_elements{0U}, encoding{Encoding::FrameOfReference} {}
+
+  explicit PackedArray(const Array<T> &values, Encoding encoding = Encoding::FrameOfReference)
+      : blocks{(values.len() + BLOCK_SIZE - 1U) / BLOCK_SIZE}, words{}, num_elements{values.len()},
+        encoding{encoding} {
+    // The width of a block is only known once it's encoded, so the blocks
+    // are packed into a growable buffer that is copied once at the end
+    std::vector<uint64_t> packed{};
+    for (size_t block = 0U; block != this->blocks.len(); ++block) {
+      U distances[BLOCK_SIZE];
+      encode_block(values, block, distances);
+      pack(distances, this->blocks[block], packed);
+    }
+
+    const size_t num_words = packed.size();
+    this->words.reserve(num_words);
+    if (num_words != 0U) {
+      memcpy(&this->words[0], packed.data(), num_words * sizeof(uint64_t));
+    }
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->num_elements; }
+
+  /**
+   * Summary:
+   *    Returns the number of bytes used to store the compressed values
+   *    including the per block headers
+   */
+  [[nodiscard]] size_t packed_bytes() const noexcept {
+    return this->words.len() * sizeof(uint64_t) + this->blocks.len() * sizeof(BlockHeader);
+  }
+
+  struct PackedArrayIterator : public Iterator<T, PackedArrayIterator> {
+    using ItemType = T;
+
+    explicit PackedArrayIterator(const PackedArray<T> &cont)
+        : cont{cont}, next_block{0U}, cursor{0U}, decoded{0U} {}
+
+    std::optional<ItemType> next() {
+      if (this->cursor == this->decoded && !decode_next_block()) {
+        return std::nullopt;
+      }
+      return std::make_optional(this->buffer[this->cursor++]);
+    }
+
+    /**
+     * Summary:
+     *    Skips whole blocks without decoding them. Only the block
+     *    we land in is decoded.
+     */
+    size_t advance_by(size_t n) {
+      const size_t buffered = this->decoded - this->cursor;
+      if (n <= buffered) {
+        this->cursor += n;
+        return n;
+      }
+
+      const PackedArray<T> &arr = this->cont.get();
+      // The last block can be partial, so the blocks we've decoded may
+      // cover less than `next_block * BLOCK_SIZE` items
+      const size_t consumed = this->next_block * BLOCK_SIZE;
+      const size_t remaining = buffered + arr.num_elements
+          - (consumed < arr.num_elements ? consumed : arr.num_elements);
+      this->cursor = this->decoded;
+      if (n >= remaining) {
+        this->next_block = arr.blocks.len();
+        return remaining;
+      }
+
+      size_t left = n - buffered;
+      this->next_block += left / BLOCK_SIZE;
+      left %= BLOCK_SIZE;
+      if (left != 0U && decode_next_block()) {
+        this->cursor = left;
+      }
+
+      return n;
+    }
+
+    std::reference_wrapper<const PackedArray<T>> cont;
+    size_t next_block;
+    size_t cursor;
+    size_t decoded;
+    T buffer[BLOCK_SIZE];
+
+  private:
+    bool decode_next_block() {
+      const PackedArray<T> &arr = this->cont.get();
+      if (this->next_block == arr.blocks.len()) {
+        return false;
+      }
+
+      arr.decode_block(this->next_block, this->buffer);
+      this->decoded = arr.block_len(this->next_block);
+      this->cursor = 0U;
+      ++this->next_block;
+      return true;
+    }
+  };
+
+  [[nodiscard]] PackedArrayIterator iter() const noexcept {
+    return PackedArrayIterator(*this);
+  }
+
+private:
+  using U = std::make_unsigned_t<T>;
+  using UnpackFn = void (*)(const uint64_t *, U *);
+
+  static constexpr size_t MAX_WIDTH = sizeof(U) * 8U;
+
+  struct BlockHeader {
+    T base;
+    T reference;
+    size_t offset;
+    uint8_t width;
+  };
+
+  [[nodiscard]] size_t block_len(size_t block) const noexcept {
+    const size_t remaining = this->num_elements - block * BLOCK_SIZE;
+    return remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+  }
+
+  /**
+   * Summary:
+   *    Computes the header of `block` (everything but its offset) and
+   *    the distances of its values from the block reference.
+   *    The distances past the end of the block are zero.
+   */
+  void encode_block(const Array<T> &values, size_t block, U *distances) {
+    const size_t start = block * BLOCK_SIZE;
+    const size_t count = block_len(block);
+    BlockHeader &header = this->blocks[block];
+
+    header.base = values[start];
+    if (this->encoding == Encoding::Delta) {
+      using S = std::make_signed_t<U>;
+      U prev = static_cast<U>(values[start]);
+      S min = 0;
+      for (size_t i = 0U; i != count; ++i) {
+        distances[i] = static_cast<U>(values[start + i]) - prev;
+        prev = static_cast<U>(values[start + i]);
+        if (static_cast<S>(distances[i]) < min) {
+          min = static_cast<S>(distances[i]);
+        }
+      }
+      header.reference = static_cast<T>(min);
+    } else {
+      T min = values[start];
+      for (size_t i = 1U; i != count; ++i) {
+        if (values[start + i] < min) {
+          min = values[start + i];
+        }
+      }
+      for (size_t i = 0U; i != count; ++i) {
+        distances[i] = static_cast<U>(values[start + i]);
+      }
+      header.reference = min;
+    }
+
+    U max = 0U;
+    for (size_t i = 0U; i != count; ++i) {
+      distances[i] -= static_cast<U>(header.reference);
+      max |= distances[i];
+    }
+    for (size_t i = count; i != BLOCK_SIZE; ++i) {
+      distances[i] = 0U;
+    }
+
+    uint8_t width = 0U;
+    while (width != MAX_WIDTH && (max >> width) != 0U) {
+      ++width;
+    }
+    header.width = width;
+  }
+
+  /**
+   * Summary:
+   *    Appends the distances of a block to `words`, `width` bits each,
+   *    and stores where they start in the header
+   */
+  static void pack(const U *distances, BlockHeader &header, std::vector<uint64_t> &words) {
+    header.offset = words.size();
+    if (header.width == 0U) {
+      return;
+    }
+
+    words.resize(words.size() + header.width * (BLOCK_SIZE / 64U), 0U);
+    uint64_t *out = &words[header.offset];
+    for (size_t i = 0U; i != BLOCK_SIZE; ++i) {
+      const size_t bit = i * header.width;
+      const size_t word = bit / 64U;
+      const size_t shift = bit % 64U;
+      const auto v = static_cast<uint64_t>(distances[i]);
+      out[word] |= v << shift;
+      if (shift + header.width > 64U) {
+        out[word + 1U] |= v >> (64U - shift);
+      }
+    }
+  }
+
+  /**
+   * Summary:
+   *    Unpacks a whole block of `Width` bits wide values.
+   *    Since the width is known at compile time, the shifts and masks
+   *    are constants and the compiler can unroll and vectorize the loop.
+   */
+  template<size_t Width>
+  static void unpack(const uint64_t *in, U *out) {
+    if constexpr (Width == 0U) {
+      for (size_t i = 0U; i != BLOCK_SIZE; ++i) {
+        out[i] = 0U;
+      }
+    } else {
+      constexpr uint64_t mask = Width == 64U ? ~uint64_t{0U} : (uint64_t{1U} << Width) - 1U;
+      for (size_t i = 0U; i != BLOCK_SIZE; ++i) {
+        const size_t bit = i * Width;
+        const size_t word = bit / 64U;
+        const size_t shift = bit % 64U;
+        uint64_t v = in[word] >> shift;
+        if (shift + Width > 64U) {
+          v |= in[word + 1U] << (64U - shift);
+        }
+        out[i] = static_cast<U>(v & mask);
+      }
+    }
+  }
+
+  template<size_t... Widths>
+  static constexpr std::array<UnpackFn, sizeof...(Widths)> make_unpackers(std::index_sequence<Widths...>) {
+    return {{&unpack<Widths>...}};
+  }
+
+  static constexpr std::array<UnpackFn, MAX_WIDTH + 1U> unpackers =
+      make_unpackers(std::make_index_sequence<MAX_WIDTH + 1U>{});
+
+  void decode_block(size_t block, T *out) const {
+    const BlockHeader &header = this->blocks[block];
+    U distances[BLOCK_SIZE];
+    unpackers[header.width](this->words.len() ? &this->words[header.offset] : nullptr, distances);
+
+    const size_t count = block_len(block);
+    const auto reference = static_cast<U>(header.reference);
+    if (this->encoding == Encoding::Delta) {
+      auto acc = static_cast<U>(header.base);
+      for (size_t i = 0U; i != count; ++i) {
+        acc += reference + distances[i];
+        out[i] = static_cast<T>(acc);
+      }
+    } else {
+      for (size_t i = 0U; i != count; ++i) {
+        out[i] = static_cast<T>(reference + distances[i]);
+      }
+    }
+  }
+
+  Array<BlockHeader> blocks;
+  Array<uint64_t> words;
+  size_t num_elements;
+  Encoding encoding;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_PACKED_ARRAY_H
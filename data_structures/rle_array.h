@@ -0,0 +1,151 @@
+#ifndef ITERATOR_DATA_STRUCTURES_RLE_ARRAY_H
+#define ITERATOR_DATA_STRUCTURES_RLE_ARRAY_H
+
+#include <type_traits>
+#include "array.h"
+
+/**
+ * Summary:
+ *      An immutable array that stores consecutive equal values as runs.
+ *      Each run is a value and the (exclusive) index where the run ends,
+ *      so locating the run of an index is a binary search.
+ *      Iterating expands the runs lazily. `count`, `sum`, `advance_by` and
+ *      therefore `nth` work on whole runs, so they cost O(runs) or less
+ *      instead of O(items).
+ *
+ * @tparam T: The type of the values
+ *
+ * @example:
+ * ```
+ * Array<int> status(6);
+ * status[0] = 1;
+ * status[1] = 1;
+ * status[2] = 1;
+ * status[3] = 2;
+ * status[4] = 2;
+ * status[5] = 1;
+ *
+ * RleArray<int> rle(status);
+ *
+ * // rle.num_runs() is 3
+ * // rle.iter().sum() is 8
+ * ```
+ */
+template<typename T>
+struct RleArray {
+  RleArray() : values{}, run_ends{}, num_elements{0U} {}
+
+  explicit RleArray(const Array<T> &array) : values{}, run_ends{}, num_elements{array.len()} {
+    size_t runs = 0U;
+    for (size_t i = 0U; i != array.len(); ++i) {
+      if (i == 0U || !(array[i] == array[i - 1U])) {
+        ++runs;
+      }
+    }
+
+    this->values.reserve(runs);
+    this->run_ends.reserve(runs);
+
+    size_t run = 0U;
+    for (size_t i = 0U; i != array.len(); ++i) {
+      if (i != 0U && !(array[i] == array[i - 1U])) {
+        ++run;
+      }
+      this->values[run] = array[i];
+      this->run_ends[run] = i + 1U;
+    }
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->num_elements; }
+
+  [[nodiscard]] size_t num_runs() const noexcept { return this->values.len(); }
+
+  struct RleArrayIterator : public Iterator<std::reference_wrapper<T>, RleArrayIterator> {
+    using ItemType = std::reference_wrapper<T>;
+    using StrippedItemType = T;
+
+    explicit RleArrayIterator(const RleArray<T> &cont) : cont{cont}, run{0U}, cursor{0U} {}
+
+    std::optional<ItemType> next() {
+      const RleArray<T> &arr = this->cont.get();
+      if (this->cursor == arr.num_elements) {
+        return std::nullopt;
+      }
+
+      if (this->cursor == arr.run_ends[this->run]) {
+        ++this->run;
+      }
+      ++this->cursor;
+      return std::make_optional(std::ref(arr.values[this->run]));
+    }
+
+    /**
+     * Summary:
+     *    Finds the run we land in with a binary search over the run ends
+     */
+    size_t advance_by(size_t n) {
+      const RleArray<T> &arr = this->cont.get();
+      const size_t remaining = arr.num_elements - this->cursor;
+      const size_t advanced = n < remaining ? n : remaining;
+      this->cursor += advanced;
+
+      size_t lo = this->run;
+      size_t hi = arr.run_ends.len();
+      while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2U;
+        if (arr.run_ends[mid] < this->cursor) {
+          lo = mid + 1U;
+        } else {
+          hi = mid;
+        }
+      }
+      this->run = lo < arr.run_ends.len() ? lo : this->run;
+
+      return advanced;
+    }
+
+    size_t count() {
+      return advance_by(this->cont.get().num_elements - this->cursor);
+    }
+
+    /**
+     * Summary:
+     *    Adds each run at once. For arithmetic types a run contributes
+     *    `value * run_length`, otherwise the value is added run_length times.
+     */
+    StrippedItemType sum() {
+      const RleArray<T> &arr = this->cont.get();
+      StrippedItemType res{};
+      while (this->cursor != arr.num_elements) {
+        if (this->cursor == arr.run_ends[this->run]) {
+          ++this->run;
+        }
+        const size_t run_length = arr.run_ends[this->run] - this->cursor;
+        if constexpr (std::is_arithmetic_v<T>) {
+          res = res + arr.values[this->run] * static_cast<T>(run_length);
+        } else {
+          for (size_t i = 0U; i != run_length; ++i) {
+            res = res + arr.values[this->run];
+          }
+        }
+        this->cursor += run_length;
+      }
+      return res;
+    }
+
+    std::reference_wrapper<const RleArray<T>> cont;
+    size_t run;
+    size_t cursor;
+  };
+
+  [[nodiscard]] RleArrayIterator iter() const noexcept {
+    return RleArrayIterator(*this);
+  }
+
+private:
+  Array<T> values;
+  Array<size_t> run_ends;
+  size_t num_elements;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_RLE_ARRAY_H
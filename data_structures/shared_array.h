@@ -0,0 +1,192 @@
+#ifndef ITERATOR_DATA_STRUCTURES_SHARED_ARRAY_H
+#define ITERATOR_DATA_STRUCTURES_SHARED_ARRAY_H
+
+#include <atomic>
+#include "array.h"
+#include "../iter_from.h"
+
+/**
+ * Summary:
+ *      An array whose buffer is shared by its copies and copied on write.
+ *      Copying a `SharedArray` (or calling `clone`) only bumps an atomic
+ *      reference count, so handing the same data to many readers, possibly
+ *      on other threads, costs nothing. The buffer is copied the first time
+ *      a copy that shares it asks to write (through `make_mut`, `iter_mut`
+ *      or `set`), so writes never show up in the other copies.
+ *      `make_mut` and `iter_mut` hand out a reference (or an iterator) into the
+ *      buffer that can still be written through after the call, so from then on
+ *      the buffer is never shared again: copies made after that get a buffer of
+ *      their own, and only `set` keeps cheap copies possible.
+ *      `iter` is a `SliceIterator` over the buffer, so reading is as fast as
+ *      reading an `Array`. It yields const references, so the shared buffer
+ *      can't be written through it.
+ *
+ * @tparam T: The type of the items
+ *
+ * @example:
+ * ```
+ * SharedArray<double> prices(load_prices());
+ *
+ * auto snapshot = prices.clone();   // O(1)
+ * prices.set(0, 42.0);              // Copies the buffer, snapshot is untouched
+ *
+ * double total = snapshot.iter().sum();
+ * ```
+ */
+template<typename T>
+struct SharedArray {
+  SharedArray() : storage{nullptr} {}
+
+  explicit SharedArray(size_t size) : storage{new Storage(Array<T>(size))} {}
+
+  /**
+   * Summary:
+   *    Takes over the buffer of an array without copying it
+   */
+  explicit SharedArray(Array<T> &&items) : storage{new Storage(std::move(items))} {}
+
+  SharedArray(const SharedArray<T> &rhs) : storage{nullptr} {
+    share(rhs.storage);
+  }
+
+  SharedArray(SharedArray<T> &&rhs) noexcept : storage{rhs.storage} {
+    rhs.storage = nullptr;
+  }
+
+  ~SharedArray() { release(); }
+
+  SharedArray &operator=(const SharedArray<T> &rhs) {
+    if (this->storage != rhs.storage) {
+      release();
+      share(rhs.storage);
+    }
+    return *this;
+  }
+
+  SharedArray &operator=(SharedArray<T> &&rhs) noexcept {
+    if (this != &rhs) {
+      release();
+      this->storage = rhs.storage;
+      rhs.storage = nullptr;
+    }
+    return *this;
+  }
+
+  template<typename IteratorType>
+  static SharedArray<T> from_iterator(IteratorType &iter) {
+    return SharedArray<T>(Array<T>::from_iterator(iter));
+  }
+
+  /**
+   * Summary:
+   *    Returns a copy that shares the buffer. It's the same as
+   *    the copy constructor, but makes the intent explicit.
+   *    If `make_mut` or `iter_mut` were called, the buffer is copied.
+   */
+  [[nodiscard]] SharedArray<T> clone() const { return *this; }
+
+  [[nodiscard]] size_t len() const noexcept { return this->storage ? this->storage->items.len() : 0U; }
+
+  const T &operator[](size_t index) const { return this->storage->items[index]; }
+
+  /**
+   * Summary:
+   *    The number of `SharedArray`s that share the buffer
+   */
+  [[nodiscard]] size_t use_count() const noexcept {
+    return this->storage ? this->storage->refs.load(std::memory_order_acquire) : 0U;
+  }
+
+  [[nodiscard]] bool is_unique() const noexcept { return use_count() == 1U; }
+
+  /**
+   * Summary:
+   *    Returns the items for writing. If the buffer is shared,
+   *    it's copied first, so that the other copies don't see the writes.
+   *    The reference can outlive the call, so the buffer is not shared
+   *    with the copies made after it either.
+   */
+  Array<T> &make_mut() {
+    Array<T> &items = unique_items();
+    this->storage->shareable = false;
+    return items;
+  }
+
+  void set(size_t index, T value) {
+    unique_items()[index] = std::move(value);
+  }
+
+  [[nodiscard]] SliceIterator<const T> iter() const noexcept {
+    if (len() == 0U) {
+      return SliceIterator<const T>(nullptr, nullptr);
+    }
+    const T *first = &this->storage->items[0U];
+    return SliceIterator<const T>(first, first + len());
+  }
+
+  /**
+   * Summary:
+   *    Returns an iterator that yields mutable references to the items,
+   *    after copying the buffer if it's shared. Like `make_mut`, it stops
+   *    the buffer from being shared with later copies.
+   */
+  [[nodiscard]] typename Array<T>::ArrayIterator iter_mut() {
+    return make_mut().iter_mut();
+  }
+
+private:
+  struct Storage {
+    explicit Storage(Array<T> &&items) : refs{1U}, shareable{true}, items{std::move(items)} {}
+
+    std::atomic<size_t> refs;
+    // False once a reference into the items was handed out. Only a buffer
+    // with a single owner is ever marked, so it doesn't need to be atomic.
+    bool shareable;
+    Array<T> items;
+  };
+
+  /**
+   * Summary:
+   *    Makes this array point to `rhs`, or to a copy of it if it can't be shared
+   */
+  void share(Storage *rhs) {
+    if (rhs && !rhs->shareable) {
+      this->storage = new Storage(Array<T>(rhs->items));
+    } else {
+      this->storage = rhs;
+      acquire();
+    }
+  }
+
+  /**
+   * Summary:
+   *    Returns the items after copying the buffer if it's shared
+   */
+  Array<T> &unique_items() {
+    if (!this->storage) {
+      this->storage = new Storage(Array<T>());
+    } else if (!is_unique()) {
+      auto *copy = new Storage(Array<T>(this->storage->items));
+      release();
+      this->storage = copy;
+    }
+    return this->storage->items;
+  }
+
+  void acquire() noexcept {
+    if (this->storage) {
+      this->storage->refs.fetch_add(1U, std::memory_order_relaxed);
+    }
+  }
+
+  void release() noexcept {
+    if (this->storage && this->storage->refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      delete this->storage;
+    }
+    this->storage = nullptr;
+  }
+
+  Storage *storage;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_SHARED_ARRAY_H
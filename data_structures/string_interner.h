@@ -0,0 +1,203 @@
+#ifndef ITERATOR_DATA_STRUCTURES_STRING_INTERNER_H
+#define ITERATOR_DATA_STRUCTURES_STRING_INTERNER_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "../iterator.h"
+
+/**
+ * Summary:
+ *      Deduplicates strings. Each distinct string is copied once into an arena
+ *      and gets a dense id. Lookups go through an open addressing (linear probing)
+ *      hash table that maps to those ids.
+ *      The string_views handed out stay valid for as long as the interner lives,
+ *      and two interned views are equal iff their `data()` pointers are equal.
+ *      Use it through the `intern` and `intern_ids` adapters of an iterator.
+ *
+ * @example:
+ * ```
+ * Array<std::string> words(3);
+ * words[0] = "foo";
+ * words[1] = "bar";
+ * words[2] = "foo";
+ *
+ * StringInterner interner{};
+ * auto interned = words.iter()
+ *      .intern(interner)
+ *      .collect<Array>();
+ *
+ * // interned[0].data() == interned[2].data()
+ * // interner.len() is 2
+ * ```
+ */
+struct StringInterner {
+  using Id = uint32_t;
+
+  static constexpr size_t CHUNK_SIZE = 64U * 1024U;
+
+  StringInterner() : slots(INITIAL_SLOTS, EMPTY), strings{}, hashes{}, chunks{}, cursor{nullptr}, remaining{0U} {}
+
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+  /**
+   * Summary:
+   *    Takes over the strings of `rhs`, which is left empty and can be used again
+   */
+  StringInterner(StringInterner &&rhs) noexcept
+      : slots{std::move(rhs.slots)}, strings{std::move(rhs.strings)}, hashes{std::move(rhs.hashes)},
+        chunks{std::move(rhs.chunks)}, cursor{rhs.cursor}, remaining{rhs.remaining} {
+    rhs.clear();
+  }
+
+  StringInterner &operator=(StringInterner &&rhs) noexcept {
+    if (this != &rhs) {
+      this->slots = std::move(rhs.slots);
+      this->strings = std::move(rhs.strings);
+      this->hashes = std::move(rhs.hashes);
+      this->chunks = std::move(rhs.chunks);
+      this->cursor = rhs.cursor;
+      this->remaining = rhs.remaining;
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  /**
+   * Summary:
+   *    Interns a string and returns its id. If the string was
+   *    interned before, the same id is returned.
+   */
+  Id intern_id(std::string_view str) {
+    if (this->slots.empty()) {
+      // Moved from
+      this->slots.assign(INITIAL_SLOTS, EMPTY);
+    }
+
+    const size_t hash = std::hash<std::string_view>{}(str);
+    size_t slot = probe(str, hash);
+    if (this->slots[slot] != EMPTY) {
+      return this->slots[slot];
+    }
+
+    // Every id but `EMPTY` is taken. There's no id to return, and
+    // handing out `EMPTY` would corrupt the table, so give up.
+    if (this->strings.size() == MAX_LEN) {
+      std::abort();
+    }
+
+    if ((this->strings.size() + 1U) * 2U > this->slots.size()) {
+      grow();
+      slot = probe(str, hash);
+    }
+
+    const auto id = static_cast<Id>(this->strings.size());
+    this->strings.push_back(store(str));
+    this->hashes.push_back(hash);
+    this->slots[slot] = id;
+    return id;
+  }
+
+  /**
+   * Summary:
+   *    Interns a string and returns a view of the stored copy
+   */
+  std::string_view intern(std::string_view str) {
+    return this->strings[intern_id(str)];
+  }
+
+  /**
+   * Summary:
+   *    Returns the id of a string if it has been interned
+   */
+  [[nodiscard]] std::optional<Id> find(std::string_view str) const {
+    if (this->slots.empty()) {
+      return std::nullopt;
+    }
+
+    const Id id = this->slots[probe(str, std::hash<std::string_view>{}(str))];
+    if (id == EMPTY) {
+      return std::nullopt;
+    }
+    return std::make_optional(id);
+  }
+
+  [[nodiscard]] std::string_view resolve(Id id) const { return this->strings[id]; }
+
+  [[nodiscard]] size_t len() const noexcept { return this->strings.size(); }
+
+private:
+  static constexpr Id EMPTY = UINT32_MAX;
+  // The ids are `0..MAX_LEN`, so that none of them is `EMPTY`
+  static constexpr size_t MAX_LEN = EMPTY;
+  static constexpr size_t INITIAL_SLOTS = 16U;
+
+  void clear() noexcept {
+    this->slots.clear();
+    this->strings.clear();
+    this->hashes.clear();
+    this->chunks.clear();
+    this->cursor = nullptr;
+    this->remaining = 0U;
+  }
+
+  [[nodiscard]] size_t probe(std::string_view str, size_t hash) const {
+    const size_t mask = this->slots.size() - 1U;
+    for (size_t slot = hash & mask;; slot = (slot + 1U) & mask) {
+      const Id id = this->slots[slot];
+      if (id == EMPTY || (this->hashes[id] == hash && this->strings[id] == str)) {
+        return slot;
+      }
+    }
+  }
+
+  void grow() {
+    this->slots.assign(this->slots.size() * 2U, EMPTY);
+    const size_t mask = this->slots.size() - 1U;
+    for (size_t id = 0U; id != this->strings.size(); ++id) {
+      size_t slot = this->hashes[id] & mask;
+      while (this->slots[slot] != EMPTY) {
+        slot = (slot + 1U) & mask;
+      }
+      this->slots[slot] = static_cast<Id>(id);
+    }
+  }
+
+  std::string_view store(std::string_view str) {
+    if (str.empty()) {
+      return {};
+    }
+
+    if (str.size() > CHUNK_SIZE / 4U) {
+      // Big strings get their own chunk so that we don't waste the current one
+      this->chunks.emplace_back(new char[str.size()]);
+      memcpy(this->chunks.back().get(), str.data(), str.size());
+      return {this->chunks.back().get(), str.size()};
+    }
+
+    if (str.size() > this->remaining) {
+      this->chunks.emplace_back(new char[CHUNK_SIZE]);
+      this->cursor = this->chunks.back().get();
+      this->remaining = CHUNK_SIZE;
+    }
+
+    memcpy(this->cursor, str.data(), str.size());
+    std::string_view res{this->cursor, str.size()};
+    this->cursor += str.size();
+    this->remaining -= str.size();
+    return res;
+  }
+
+  std::vector<Id> slots;
+  std::vector<std::string_view> strings;
+  std::vector<size_t> hashes;
+  std::vector<std::unique_ptr<char[]>> chunks;
+  char *cursor;
+  size_t remaining;
+};
+
+#endif //ITERATOR_DATA_STRUCTURES_STRING_INTERNER_H
@@ -0,0 +1,343 @@
+#ifndef ITERATOR__ITER_FROM_H
+#define ITERATOR__ITER_FROM_H
+
+#include <iterator>
+#include <type_traits>
+#include "iterator.h"
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+/**
+ * Summary:
+ *      An iterator over a contiguous range of memory `[first, last)`.
+ *      It yields references to the items, can be consumed from both ends
+ *      and supports random access, so `advance_by`, `nth` and `count` are O(1).
+ *      To get an iterator of this type, call `iter_from` with a pointer and a length,
+ *      a pointer range, a `std::span` or a contiguous container.
+ *
+ * @tparam T: The type of the items. It's const for read only ranges
+ *
+ * @example:
+ * ```
+ * std::vector<int> ints{1, 2, 3, 4};
+ *
+ * int sum = iter_from(ints)
+ *      .skip(1)
+ *      .sum();
+ *
+ * // sum is 9
+ * ```
+ */
+template<typename T>
+struct SliceIterator : public Iterator<std::reference_wrapper<T>, SliceIterator<T>> {
+  using ItemType = std::reference_wrapper<T>;
+
+  SliceIterator(T *first, T *last) : first{first}, last{last} {}
+
+  std::optional<ItemType> next() {
+    if (this->first != this->last) {
+      return std::make_optional(std::ref(*this->first++));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<ItemType> next_back() {
+    if (this->first != this->last) {
+      return std::make_optional(std::ref(*--this->last));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return static_cast<size_t>(this->last - this->first); }
+
+  /**
+   * Summary:
+   *    Random access to the remaining items. Index 0 is the item
+   *    that `next` would yield.
+   */
+  ItemType operator[](size_t index) const { return std::ref(this->first[index]); }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  size_t advance_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->first += advanced;
+    return advanced;
+  }
+
+  size_t advance_back_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->last -= advanced;
+    return advanced;
+  }
+
+  size_t count() {
+    return advance_by(len());
+  }
+
+  /**
+   * Summary:
+   *    Same as `Iterator::position_of`, but it searches the memory directly
+   */
+  std::optional<size_t> position_of(const std::remove_const_t<T> &value) {
+    const size_t index = internal::find_value<std::remove_const_t<T>>(this->first, len(), value);
+    if (index == len()) {
+      advance_by(len());
+      return std::nullopt;
+    }
+    advance_by(index + 1U);
+    return std::make_optional(index);
+  }
+
+  T *first;
+  T *last;
+};
+
+/**
+ * Summary:
+ *      An iterator over a pair of standard library iterators `[current, last)`.
+ *      That's what you get for node based containers like `std::list`, `std::map`
+ *      or `std::set`. `next_back` is available for bidirectional iterators and
+ *      `advance_by` is O(1) for random access ones.
+ *      To get an iterator of this type, call `iter_from` with a pair of iterators
+ *      or a container that is not contiguous.
+ *
+ * @tparam It: The type of the standard library iterator
+ *
+ * @example:
+ * ```
+ * std::set<int> ints{3, 1, 2};
+ *
+ * auto res = iter_from(ints)
+ *      .map([](const int &v) { return v * 10; })
+ *      .collect<Array>();
+ *
+ * // res is: [10, 20, 30]
+ * ```
+ */
+template<typename It>
+struct StdIterator : public Iterator<std::reference_wrapper<std::remove_reference_t<
+    typename std::iterator_traits<It>::reference>>, StdIterator<It>> {
+  static_assert(std::is_reference_v<typename std::iterator_traits<It>::reference>,
+                "The standard iterator must yield references");
+
+  using ItemType = std::reference_wrapper<std::remove_reference_t<typename std::iterator_traits<It>::reference>>;
+  using Category = typename std::iterator_traits<It>::iterator_category;
+
+  static constexpr bool is_random_access = std::is_base_of_v<std::random_access_iterator_tag, Category>;
+
+  StdIterator(It current, It last) : current{current}, last{last} {}
+
+  std::optional<ItemType> next() {
+    if (this->current != this->last) {
+      return std::make_optional(std::ref(*this->current++));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<ItemType> next_back() {
+    if (this->current != this->last) {
+      return std::make_optional(std::ref(*--this->last));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    if constexpr (is_random_access) {
+      const auto remaining = static_cast<size_t>(this->last - this->current);
+      return std::make_pair(remaining, std::make_optional(remaining));
+    } else {
+      return {this->current == this->last ? 0U : 1U, std::nullopt};
+    }
+  }
+
+  size_t advance_by(size_t n) {
+    if constexpr (is_random_access) {
+      const auto remaining = static_cast<size_t>(this->last - this->current);
+      const size_t advanced = n < remaining ? n : remaining;
+      this->current += advanced;
+      return advanced;
+    } else {
+      size_t advanced = 0U;
+      for (; advanced != n && this->current != this->last; ++advanced) {
+        ++this->current;
+      }
+      return advanced;
+    }
+  }
+
+  It current;
+  It last;
+};
+
+/**
+ * Summary:
+ *      An iterator over `len` items that are `stride` items apart in memory,
+ *      starting at `first`. That's what you need to walk a column of a row major
+ *      matrix or a field of an interleaved buffer without copying it.
+ *      It yields references, can be consumed from both ends and is random access.
+ *      To get an iterator of this type, call `strided`.
+ *
+ * @tparam T: The type of the items
+ *
+ * @example:
+ * ```
+ * // x, y, z interleaved
+ * float points[] = {1, 2, 3, 4, 5, 6};
+ *
+ * float sum_y = strided(points + 1, 2, 3).sum();
+ *
+ * // sum_y is 7
+ * ```
+ */
+template<typename T>
+struct StridedIterator : public Iterator<std::reference_wrapper<T>, StridedIterator<T>> {
+  using ItemType = std::reference_wrapper<T>;
+
+  StridedIterator(T *first, size_t len, size_t stride) : first{first}, cursor{0U}, limit{len}, stride{stride} {}
+
+  std::optional<ItemType> next() {
+    if (this->cursor < this->limit) {
+      return std::make_optional(at(this->cursor++));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<ItemType> next_back() {
+    if (this->cursor < this->limit) {
+      return std::make_optional(at(--this->limit));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->limit - this->cursor; }
+
+  ItemType operator[](size_t index) const { return at(this->cursor + index); }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  size_t advance_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->cursor += advanced;
+    return advanced;
+  }
+
+  size_t advance_back_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    this->limit -= advanced;
+    return advanced;
+  }
+
+  size_t count() {
+    return advance_by(len());
+  }
+
+  // `first` never moves. The address of an item is only computed when
+  // it's read, so no pointer past the end of the buffer is ever formed.
+  T *first;
+  size_t cursor;
+  size_t limit;
+  size_t stride;
+
+private:
+  [[nodiscard]] ItemType at(size_t index) const { return std::ref(this->first[index * this->stride]); }
+};
+
+namespace internal {
+template<typename Container, typename = void>
+struct is_contiguous_container : std::false_type {};
+
+template<typename Container>
+struct is_contiguous_container<Container, std::void_t<decltype(std::declval<Container &>().data()),
+                                                      decltype(std::declval<Container &>().size())>>
+    : std::is_pointer<decltype(std::declval<Container &>().data())> {};
+
+/**
+ * Summary:
+ *      Determines whether a container stores its items contiguously,
+ *      which we detect by the container having `data()` and `size()`
+ *      (e.g. std::vector, std::array, std::string)
+ */
+template<typename Container>
+inline constexpr bool is_contiguous_container_v = is_contiguous_container<Container>::value;
+}
+
+/**
+ * Summary:
+ *      Creates an iterator over `len` items starting at `ptr`
+ */
+template<typename T>
+SliceIterator<T> iter_from(T *ptr, size_t len) {
+  return SliceIterator<T>(ptr, ptr + len);
+}
+
+/**
+ * Summary:
+ *      Creates an iterator over the items in `[first, last)`
+ */
+template<typename T>
+SliceIterator<T> iter_from(T *first, T *last) {
+  return SliceIterator<T>(first, last);
+}
+
+/**
+ * Summary:
+ *      Creates an iterator over the items in `[first, last)`
+ *      given a pair of standard library iterators
+ */
+template<typename It>
+StdIterator<It> iter_from(It first, It last) {
+  return StdIterator<It>(first, last);
+}
+
+/**
+ * Summary:
+ *      Creates an iterator over the items of a standard library container
+ *      without copying them. Contiguous containers get a `SliceIterator`,
+ *      every other container gets a `StdIterator`. The container must outlive
+ *      the iterator.
+ */
+template<typename Container>
+auto iter_from(Container &container) {
+  if constexpr (internal::is_contiguous_container_v<Container>) {
+    return iter_from(container.data(), container.size());
+  } else {
+    return iter_from(std::begin(container), std::end(container));
+  }
+}
+
+/**
+ * Summary:
+ *      Creates an iterator over `len` items that are `stride` items apart, starting at `ptr`
+ */
+template<typename T>
+StridedIterator<T> strided(T *ptr, size_t len, size_t stride) {
+  return StridedIterator<T>(ptr, len, stride);
+}
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+
+/**
+ * Summary:
+ *      Creates an iterator over the items of a `std::span`
+ */
+template<typename T, size_t Extent>
+SliceIterator<T> iter_from(std::span<T, Extent> span) {
+  return SliceIterator<T>(span.data(), span.data() + span.size());
+}
+
+#endif
+
+#endif //ITERATOR__ITER_FROM_H
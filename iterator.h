@@ -1,9 +1,22 @@
 #ifndef ITERATOR__ITERATOR_H
 #define ITERATOR__ITERATOR_H
 
+#include <algorithm>
+#include <cassert>
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_set>
+#include <variant>
+#include <vector>
 
 /**
  * Summary:
@@ -63,13 +76,15 @@ struct strip_ref_wrapper {
 
 /**
  * Summary:
- *      Trait to strip std::reference_wrapper from a type
+ *      Trait to strip std::reference_wrapper from a type.
+ *      The constness of the referenced type is stripped as well,
+ *      since the stripped type is used for values we own.
  *
  * @tparam T: The type that we want to remove std::reference_wrapper
  */
 template<typename T>
 struct strip_ref_wrapper<std::reference_wrapper<T>> {
-  using type = T;
+  using type = std::remove_cv_t<T>;
 };
 
 /**
@@ -105,8 +120,364 @@ using item_type = typename IteratorType::ItemType;
 
 template<typename IteratorType>
 using unwraped_item_type = unwrap_ref_wrapper_t<typename IteratorType::ItemType>;
+
+template<typename IteratorType, typename = void>
+struct is_random_access : std::false_type {};
+
+template<typename IteratorType>
+struct is_random_access<IteratorType, std::void_t<decltype(std::declval<const IteratorType &>().len()),
+                                                  decltype(std::declval<const IteratorType &>()[size_t{}])>>
+    : std::true_type {};
+
+/**
+ * Summary:
+ *      Determines whether an iterator supports random access to its remaining items.
+ *      Such iterators implement `len()`, which returns the number of remaining items,
+ *      and `operator[]`, where index 0 is the item that `next` would yield.
+ *
+ * @tparam IteratorType: The type of the iterator
+ */
+template<typename IteratorType>
+inline constexpr bool is_random_access_v = is_random_access<IteratorType>::value;
+
+/**
+ * Summary:
+ *      Enables a member function only when the iterator(s) of type `Its...` are random access
+ */
+template<typename... Its>
+using enable_if_random_access_t = std::enable_if_t<(is_random_access_v<Its> && ...)>;
+
+/**
+ * Summary:
+ *      Checks whether the 8 bytes of a little endian word are all ASCII digits
+ */
+inline bool is_eight_digits(uint64_t word) noexcept {
+  return ((word & 0xF0F0F0F0F0F0F0F0U) | (((word + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4U)) ==
+         0x3333333333333333U;
+}
+
+/**
+ * Summary:
+ *      Parses 8 ASCII digits stored in a little endian word,
+ *      combining pairs of digits, then pairs of pairs, etc.
+ */
+inline uint64_t parse_eight_digits(uint64_t word) noexcept {
+  word = ((word & 0x0F0F0F0F0F0F0F0FU) * 2561U) >> 8U;
+  word = ((word & 0x00FF00FF00FF00FFU) * 6553601U) >> 16U;
+  return ((word & 0x0000FFFF0000FFFFU) * 42949672960001U) >> 32U;
+}
+
+/**
+ * Summary:
+ *      Parses a decimal integer of 8 to 16 digits, 8 digits at a time
+ *
+ * @return: The number, or std::nullopt if `digits` is not 8 to 16 digits
+ */
+inline std::optional<uint64_t> parse_long_digits(std::string_view digits) noexcept {
+  if (digits.size() < 8U || digits.size() > 16U) {
+    return std::nullopt;
+  }
+
+  uint64_t low;
+  memcpy(&low, digits.data() + digits.size() - 8U, sizeof(low));
+  if (!is_eight_digits(low)) {
+    return std::nullopt;
+  }
+
+  uint64_t high = 0U;
+  if (digits.size() == 16U) {
+    uint64_t word;
+    memcpy(&word, digits.data(), sizeof(word));
+    if (!is_eight_digits(word)) {
+      return std::nullopt;
+    }
+    high = parse_eight_digits(word);
+  } else {
+    for (size_t i = 0U; i != digits.size() - 8U; ++i) {
+      const auto digit = static_cast<unsigned char>(digits[i] - '0');
+      if (digit > 9U) {
+        return std::nullopt;
+      }
+      high = high * 10U + digit;
+    }
+  }
+
+  return std::make_optional(high * 100000000U + parse_eight_digits(low));
+}
+
+/**
+ * Summary:
+ *      Returns the index of the first of the `n` items starting at `first` that is
+ *      equal to `value`, or `n` if there is none. Bytes are searched with `memchr`,
+ *      which the C library vectorises. Other arithmetic types are compared eight at
+ *      a time into a bitmask without branching, so the compiler can vectorise the
+ *      comparisons, and only a non zero mask is scanned for the match.
+ */
+template<typename T>
+size_t find_value(const T *first, size_t n, const T &value) {
+  if constexpr (std::is_integral_v<T> && sizeof(T) == 1U) {
+    const void *found = memchr(first, static_cast<unsigned char>(value), n);
+    return found != nullptr ? static_cast<size_t>(static_cast<const T *>(found) - first) : n;
+  } else {
+    size_t i = 0U;
+    if constexpr (std::is_arithmetic_v<T>) {
+      constexpr size_t lanes = 8U;
+      for (; i + lanes <= n; i += lanes) {
+        unsigned mask = 0U;
+        for (size_t lane = 0U; lane != lanes; ++lane) {
+          mask |= static_cast<unsigned>(first[i + lane] == value) << lane;
+        }
+        if (mask != 0U) {
+          break;
+        }
+      }
+    }
+    for (; i != n; ++i) {
+      if (first[i] == value) {
+        return i;
+      }
+    }
+    return n;
+  }
+}
+
+/**
+ * Summary:
+ *      Calls a fold function with the accumulator and an item. The accumulator
+ *      is moved into the function, unless the function takes it by non const
+ *      reference, in which case it's passed as is.
+ */
+template<typename F, typename Acc, typename Item>
+decltype(auto) call_folder(F &func, Acc &acc, Item &&item) {
+  if constexpr (std::is_invocable_v<F &, Acc &&, Item &&>) {
+    return func(std::move(acc), std::forward<Item>(item));
+  } else {
+    return func(acc, std::forward<Item>(item));
+  }
+}
+
+/**
+ * Summary:
+ *      The type of the accumulator that a fold function returns
+ */
+template<typename F, typename Acc, typename Item>
+using fold_result_t = std::decay_t<decltype(call_folder(std::declval<F &>(), std::declval<Acc &>(),
+                                                        std::declval<Item>()))>;
+
+/**
+ * Summary:
+ *      The type of the accumulator of `fold`. If the function can't take the
+ *      initial value (e.g. `fold(0, [](double &acc, const double &v) { ... })`),
+ *      the accumulator is `Fallback`, the item type, which is built from the initial value.
+ */
+template<typename F, typename Init, typename Item, typename Fallback, typename = void>
+struct fold_acc {
+  using type = Fallback;
+};
+
+template<typename F, typename Init, typename Item, typename Fallback>
+struct fold_acc<F, Init, Item, Fallback, std::enable_if_t<std::is_invocable_v<F &, Init &&, Item>
+                                                          || std::is_invocable_v<F &, Init &, Item>>> {
+  using type = fold_result_t<F, Init, Item>;
+};
+
+template<typename F, typename Init, typename Item, typename Fallback>
+using fold_acc_t = typename fold_acc<F, Init, Item, Fallback>::type;
+
+/**
+ * Summary:
+ *      Hints the CPU to bring the cache line at `addr` into the cache
+ */
+inline void prefetch(const void *addr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#else
+  (void) addr;
+#endif
+}
+
+/**
+ * Summary:
+ *      Parses a whole token into a number using `std::from_chars`.
+ *      Long decimal integers take a faster path that parses 8 digits at a time.
+ *
+ * @tparam T:    The type of the number
+ * @param token: The text to parse
+ * @param value: Where the parsed number is stored on success
+ * @return:      A default constructed std::errc on success, the error otherwise
+ */
+template<typename T>
+std::errc parse_number(std::string_view token, T &value) {
+  if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(uint64_t)) {
+    const bool negative = std::is_signed_v<T> && !token.empty() && token[0] == '-';
+    const auto digits = negative ? token.substr(1U) : token;
+    const auto parsed = parse_long_digits(digits);
+    if (parsed.has_value()) {
+      const auto max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+      if (*parsed > (negative ? max + 1U : max)) {
+        return std::errc::result_out_of_range;
+      }
+      value = static_cast<T>(negative ? 0U - *parsed : *parsed);
+      return std::errc{};
+    }
+  }
+
+  const char *end = token.data() + token.size();
+  auto[ptr, error] = std::from_chars(token.data(), end, value);
+  if (error == std::errc{} && ptr != end) {
+    return std::errc::invalid_argument;
+  }
+  return error;
+}
+}
+
+/**
+ * Summary:
+ *      The result of parsing a token with the `try_parse` adapter.
+ *      `value` is only meaningful if `ok` returns true.
+ *
+ * @tparam T: The type of the parsed number
+ */
+template<typename T>
+struct ParseResult {
+  T value;
+  std::errc error;
+
+  [[nodiscard]] bool ok() const noexcept { return error == std::errc{}; }
+};
+
+/**
+ * Summary:
+ *      Wraps an error so that it can be converted to a `Result`.
+ *      With class template argument deduction you don't have to
+ *      name the type of the error.
+ *
+ * @tparam E: The type of the error
+ *
+ * @example:
+ * ```
+ * Result<int, ParseError> parse_digit(char c) {
+ *     if (c < '0' || c > '9') {
+ *         return Err{ParseError::NotADigit};
+ *     }
+ *     return c - '0';
+ * }
+ * ```
+ */
+template<typename E>
+struct Err {
+  E error;
+};
+
+template<typename E>
+Err(E) -> Err<E>;
+
+/**
+ * Summary:
+ *      Holds either a value or the error that prevented computing it.
+ *      It's the item type of the `try_map` and `try_filter` adapters, which
+ *      stop a pipeline at the first error and hand it to `try_collect`, so
+ *      errors can be propagated without exceptions. Nothing in it throws,
+ *      so it works in builds without exceptions. Reading the value of an
+ *      error (or the error of a value) is undefined, like dereferencing an
+ *      empty `std::optional`.
+ *      It converts to true when it holds a value, so it also works with `try_fold`.
+ *
+ * @tparam T: The type of the value
+ * @tparam E: The type of the error
+ *
+ * @example:
+ * ```
+ * Result<int, ParseError> res = parse_digit('7');
+ *
+ * if (res) {
+ *     // *res is 7
+ * } else {
+ *     // res.error() tells why
+ * }
+ * ```
+ */
+template<typename T, typename E>
+struct Result {
+  using ValueType = T;
+  using ErrorType = E;
+
+  Result(T value) : storage{std::in_place_index<0U>, std::move(value)} {}
+
+  template<typename G, typename = std::enable_if_t<std::is_convertible_v<G, E>>>
+  Result(Err<G> err) : storage{std::in_place_index<1U>, std::move(err.error)} {}
+
+  [[nodiscard]] bool is_ok() const noexcept { return this->storage.index() == 0U; }
+
+  [[nodiscard]] bool is_err() const noexcept { return this->storage.index() == 1U; }
+
+  explicit operator bool() const noexcept { return is_ok(); }
+
+  T &value() & { return *std::get_if<0U>(&this->storage); }
+  const T &value() const & { return *std::get_if<0U>(&this->storage); }
+  T &&value() && { return std::move(*std::get_if<0U>(&this->storage)); }
+
+  E &error() & { return *std::get_if<1U>(&this->storage); }
+  const E &error() const & { return *std::get_if<1U>(&this->storage); }
+  E &&error() && { return std::move(*std::get_if<1U>(&this->storage)); }
+
+  T &operator*() & { return value(); }
+  const T &operator*() const & { return value(); }
+  T &&operator*() && { return std::move(*this).value(); }
+
+  T *operator->() { return std::get_if<0U>(&this->storage); }
+  const T *operator->() const { return std::get_if<0U>(&this->storage); }
+
+  /**
+   * Summary:
+   *    Returns the value, or `fallback` if there is an error
+   */
+  template<typename U>
+  T value_or(U &&fallback) const & {
+    return is_ok() ? value() : static_cast<T>(std::forward<U>(fallback));
+  }
+
+private:
+  std::variant<T, E> storage;
+};
+
+namespace internal {
+/**
+ * Summary:
+ *      Tells whether a type is a `Result`. For a `Result`, `Arg` is what
+ *      `try_map` and `try_filter` hand to their functions, which is the value.
+ *      For every other type it's the item itself.
+ */
+template<typename T>
+struct result_traits {
+  static constexpr bool is_result = false;
+  using Arg = T;
+};
+
+template<typename T, typename E>
+struct result_traits<Result<T, E>> {
+  static constexpr bool is_result = true;
+  using Arg = T &;
+  using Value = T;
+  using Error = E;
+};
+
+template<typename T>
+inline constexpr bool is_result_v = result_traits<T>::is_result;
+
+template<typename IteratorType>
+using try_arg_t = typename result_traits<unwraped_item_type<IteratorType>>::Arg;
 }
 
+/**
+ * Summary:
+ *      Tells `try_for_each` whether to go on with the next item or to stop
+ */
+enum class ControlFlow {
+  Continue,
+  Break
+};
+
 // Forward declare Iterator
 template<typename ItemType, typename IteratorType> struct Iterator;
 
@@ -144,16 +515,39 @@ struct StepBy : public Iterator<internal::item_type<IteratorType>, StepBy<Iterat
     std::optional<ItemType> v = inner.next();
 
     if (v.has_value()) {
-      for (size_t i = 1U; i != step; ++i) {
-        if (!inner.next().has_value()) {
-          break;
-        }
-      }
+      inner.advance_by(step - 1U);
     }
 
     return v;
   }
 
+  /**
+   * Summary:
+   *    When the underlying iterator is random access, stepping is
+   *    just index arithmetic, so advancing (and `nth`) is O(1).
+   */
+  size_t advance_by(size_t n) {
+    if constexpr (internal::is_random_access_v<IteratorType>) {
+      const size_t advanced = n < len() ? n : len();
+      inner.advance_by(advanced * step);
+      return advanced;
+    } else {
+      return Iterator<ItemType, StepBy<IteratorType>>::advance_by(n);
+    }
+  }
+
+  size_t advance_read_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    inner.advance_read_by(advanced * step);
+    return advanced;
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return (inner.len() + step - 1U) / step; }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const { return inner[index * step]; }
+
   IteratorType inner;
   size_t step;
 };
@@ -163,6 +557,12 @@ struct StepBy : public Iterator<internal::item_type<IteratorType>, StepBy<Iterat
  *      An iterator type that maps items yielded from the
  *      underlying iterator to some other value using a
  *      callable object of type `MapF`.
+ *      The mapping function is called for every item the iterator
+ *      goes past, including the ones that `advance_by` (and so `skip`,
+ *      `step_by` and `nth`) discards, so its side effects don't depend
+ *      on how the iterator is consumed. The exception is a random access
+ *      pipeline read by index (`for_each`, `try_for_each`, `zip_reduce`,
+ *      `collect`, ...), which calls it only for the items it reads.
  *      To get an iterator of this type, invoke `map` method
  *      on an iterator.
  *
@@ -202,6 +602,21 @@ struct Map : public Iterator<std::result_of_t<MapF(internal::unwraped_item_type<
     }
   }
 
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len(); }
+
+  /**
+   * Summary:
+   *    Advances past items that were already read by index, without
+   *    calling the mapping function for them again
+   */
+  size_t advance_read_by(size_t n) {
+    return inner.advance_read_by(n);
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const { return mapper(inner[index]); }
+
   IteratorType inner;
   MapF mapper;
 };
@@ -239,15 +654,35 @@ struct Skip : public Iterator<internal::item_type<IteratorType>, Skip<IteratorTy
 
   std::optional<ItemType> next() {
     if (skip) {
-      for (size_t i = 0U; i != skip; ++i) {
-        inner.next();
-      }
+      inner.advance_by(skip);
       skip = 0;
     }
 
     return inner.next();
   }
 
+  size_t advance_by(size_t n) {
+    if (skip) {
+      inner.advance_by(skip);
+      skip = 0;
+    }
+
+    return inner.advance_by(n);
+  }
+
+  size_t advance_read_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    inner.advance_read_by(skip + advanced);
+    skip = 0;
+    return advanced;
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len() > skip ? inner.len() - skip : 0U; }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const { return inner[skip + index]; }
+
   IteratorType inner;
   size_t skip;
 };
@@ -329,9 +764,8 @@ struct SkipWhile : public Iterator<internal::item_type<IteratorType>, SkipWhile<
  * // Index: 0, String: First String
  * // Index: 1, String: Second String
  * // Index; 2, String: Third String
- * foreach(it, strings.iter().enumerate()) {
- *      auto[index, str] = *it;
- *      printf("Index: %zu, String: %s\n", index, str);
+ * for (const auto &[index, str] : strings.iter().enumerate()) {
+ *      printf("Index: %zu, String: %s\n", index, str.get());
  * }
  * ```
  */
@@ -352,6 +786,24 @@ struct Enumerate : public Iterator<std::pair<size_t, internal::item_type<Iterato
     }
   }
 
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len(); }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t i) const { return std::make_pair(index + i, inner[i]); }
+
+  size_t advance_by(size_t n) {
+    const size_t advanced = inner.advance_by(n);
+    index += advanced;
+    return advanced;
+  }
+
+  size_t advance_read_by(size_t n) {
+    const size_t advanced = inner.advance_read_by(n);
+    index += advanced;
+    return advanced;
+  }
+
   IteratorType inner;
   size_t index;
 };
@@ -520,6 +972,36 @@ struct Zip : public Iterator<std::pair<internal::item_type<FirstIterator>, inter
     return std::nullopt;
   }
 
+  template<typename First = FirstIterator, typename Second = SecondIterator,
+      typename = internal::enable_if_random_access_t<First, Second>>
+  [[nodiscard]] size_t len() const { return first.len() < second.len() ? first.len() : second.len(); }
+
+  template<typename First = FirstIterator, typename Second = SecondIterator,
+      typename = internal::enable_if_random_access_t<First, Second>>
+  ItemType operator[](size_t index) const { return std::make_pair(first[index], second[index]); }
+
+  /**
+   * Summary:
+   *    Advances both sides directly when they are random access
+   */
+  size_t advance_by(size_t n) {
+    if constexpr (internal::is_random_access_v<FirstIterator> && internal::is_random_access_v<SecondIterator>) {
+      const size_t advanced = n < len() ? n : len();
+      first.advance_by(advanced);
+      second.advance_by(advanced);
+      return advanced;
+    } else {
+      return Iterator<ItemType, Zip<FirstIterator, SecondIterator>>::advance_by(n);
+    }
+  }
+
+  size_t advance_read_by(size_t n) {
+    const size_t advanced = n < len() ? n : len();
+    first.advance_read_by(advanced);
+    second.advance_read_by(advanced);
+    return advanced;
+  }
+
   FirstIterator first;
   SecondIterator second;
 };
@@ -561,6 +1043,24 @@ struct Take : public Iterator<internal::item_type<IteratorType>, Take<IteratorTy
     return std::nullopt;
   }
 
+  size_t advance_by(size_t n) {
+    const size_t advanced = inner.advance_by(n < num ? n : num);
+    num -= advanced;
+    return advanced;
+  }
+
+  size_t advance_read_by(size_t n) {
+    const size_t advanced = inner.advance_read_by(n < num ? n : num);
+    num -= advanced;
+    return advanced;
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len() < num ? inner.len() : num; }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const { return inner[index]; }
+
   IteratorType inner;
   size_t num;
 };
@@ -883,47 +1383,1085 @@ struct UniqueBy : public Iterator<internal::strip_ref_wrapper_t<internal::item_t
 
 /**
  * Summary:
- *      That's the heart of the iterator.
- *      It's a base class which uses CRTP (Curiously Recurring Template Pattern)
- *      to automatically implement all the iterator methods for a user defined
- *      iterator. It defines all the methods an iterator can have. All methods
- *      make use of the `next` method which is the only method you will need to
- *      implement. Everything else is already implemented. However, if you can
- *      provide a better implementation for some of the methods, then you can shadow
- *      the methods here by reimplementing them in the specific iterator type.
- *      What you need to provide when implementing an iterator is the type of the item
- *      that the iterator will yield (for references use std::reference_wrapper<T>).
- *      This type must be supplied when inheriting from the `Iterator` type as well
- *      as as a member type of your iterator. Also you need to implement the `next`
- *      method.
+ *      An iterator that run-length encodes the items of another iterator.
+ *      Consecutive equal items are collapsed into a single `std::pair` holding
+ *      a copy of the first item of the run and the length of the run.
+ *      Equality is determined by the equality operator (==) of the item type.
+ *      To get an iterator of this type, invoke `rle` method on an iterator.
  *
- *      e.g:
- *      template<typename T>
- *      struct MyCollection {
- *          // In place of T in specialization below, pass std::reference_wrapper<T>
- *          // to yield by reference
- *          struct MyCollectionIterator : public Iterator<T, MyCollectionIterator> {
- *              using ItemType = T; // That's by value yielding. It will cause copy construction/assignment
- *              // using ItemType = std::reference_wrapper<T> if you want to yield by reference
+ * @tparam IteratorType: The type of the underlying iterator
  *
- *              std::optional<ItemType> next() { ... }
- *          };
- *      };
+ * @example:
+ * ```
+ * Array<char> status(6);
+ * status[0] = 'a';
+ * status[1] = 'a';
+ * status[2] = 'a';
+ * status[3] = 'b';
+ * status[4] = 'a';
+ * status[5] = 'a';
+ *
+ * auto runs = status.iter()
+ *      .rle()
+ *      .collect<Array>();
  *
- * @tparam ItemType:     The type of the item that the iterator will yield
- * @tparam IteratorType: The type of the iterator that is implementing the functionality
+ * // runs is: [('a', 3), ('b', 1), ('a', 2)]
+ * ```
  */
-template<typename ItemType, typename IteratorType>
-struct Iterator {
-  /**
-   * Summary:
-   *    Creates a `StepBy` iterator with given `step`
-   *
-   * @param step: The amount of stepping to perform
-   * @return: A `StepBy` iterator
-   */
-  [[nodiscard]]
-  StepBy<IteratorType> step_by(size_t step) {
+template<typename IteratorType>
+struct Rle : public Iterator<std::pair<internal::strip_ref_wrapper_t<internal::item_type<IteratorType>>, size_t>,
+                             Rle<IteratorType>> {
+  using ItemType = std::pair<internal::strip_ref_wrapper_t<internal::item_type<IteratorType>>, size_t>;
+  using ValueRef = const internal::unwraped_item_type<IteratorType> &;
+
+  explicit Rle(IteratorType it) : inner{it}, pending{} {}
+
+  std::optional<ItemType> next() {
+    if (!pending.has_value()) {
+      pending = inner.next();
+      if (!pending.has_value()) {
+        return std::nullopt;
+      }
+    }
+
+    auto value = *pending;
+    size_t run_length = 0U;
+    do {
+      ++run_length;
+      pending = inner.next();
+    } while (pending.has_value() && static_cast<ValueRef>(*pending) == static_cast<ValueRef>(value));
+
+    return std::make_optional(ItemType(static_cast<ValueRef>(value), run_length));
+  }
+
+  IteratorType inner;
+  std::optional<internal::item_type<IteratorType>> pending;
+};
+
+/**
+ * Summary:
+ *      An iterator that interns the items of another iterator using
+ *      an interner (see `StringInterner`) and yields the interned `std::string_view`s.
+ *      Equal items are yielded as views of the same storage, which stays alive
+ *      for as long as the interner does.
+ *      The items must be convertible to `std::string_view`.
+ *      To get an iterator of this type, invoke `intern` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam Interner:     The type of the interner
+ *
+ * @example:
+ * ```
+ * Array<std::string> words(3);
+ * words[0] = "foo";
+ * words[1] = "bar";
+ * words[2] = "foo";
+ *
+ * StringInterner interner{};
+ * auto interned = words.iter()
+ *      .intern(interner)
+ *      .collect<Array>();
+ *
+ * // interned is: ["foo", "bar", "foo"] and interned[0].data() == interned[2].data()
+ * ```
+ */
+template<typename IteratorType, typename Interner>
+struct Intern : public Iterator<std::string_view, Intern<IteratorType, Interner>> {
+  using ItemType = std::string_view;
+  using ValueRef = const internal::unwraped_item_type<IteratorType> &;
+
+  Intern(IteratorType it, Interner &interner) : inner{it}, interner{interner} {}
+
+  std::optional<ItemType> next() {
+    auto v = inner.next();
+    if (v.has_value()) {
+      return std::make_optional(interner.get().intern(static_cast<ValueRef>(*v)));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  IteratorType inner;
+  std::reference_wrapper<Interner> interner;
+};
+
+/**
+ * Summary:
+ *      Same as `Intern` but yields the ids of the interned items instead.
+ *      To get an iterator of this type, invoke `intern_ids` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam Interner:     The type of the interner
+ */
+template<typename IteratorType, typename Interner>
+struct InternIds : public Iterator<typename Interner::Id, InternIds<IteratorType, Interner>> {
+  using ItemType = typename Interner::Id;
+  using ValueRef = const internal::unwraped_item_type<IteratorType> &;
+
+  InternIds(IteratorType it, Interner &interner) : inner{it}, interner{interner} {}
+
+  std::optional<ItemType> next() {
+    auto v = inner.next();
+    if (v.has_value()) {
+      return std::make_optional(interner.get().intern_id(static_cast<ValueRef>(*v)));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  IteratorType inner;
+  std::reference_wrapper<Interner> interner;
+};
+
+/**
+ * Summary:
+ *      An iterator that yields the items of another iterator in reverse order.
+ *      The underlying iterator must be double ended, which means it must
+ *      implement a `next_back` method that yields items from its back.
+ *      To get an iterator of this type, invoke `rev` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ *
+ * @example:
+ * ```
+ * auto res = split("a,b,c", ',')
+ *      .rev()
+ *      .collect<Array>();
+ *
+ * // res is: ["c", "b", "a"]
+ * ```
+ */
+template<typename IteratorType>
+struct Rev : public Iterator<internal::item_type<IteratorType>, Rev<IteratorType>> {
+  using ItemType = internal::item_type<IteratorType>;
+
+  explicit Rev(IteratorType it) : inner{it} {}
+
+  std::optional<ItemType> next() {
+    return inner.next_back();
+  }
+
+  std::optional<ItemType> next_back() {
+    return inner.next();
+  }
+
+  size_t advance_by(size_t n) {
+    return inner.advance_back_by(n);
+  }
+
+  size_t advance_back_by(size_t n) {
+    return inner.advance_by(n);
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len(); }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const { return inner[inner.len() - 1U - index]; }
+
+  IteratorType inner;
+};
+
+/**
+ * Summary:
+ *      An iterator that parses the items of another iterator into numbers
+ *      of type `T` using `std::from_chars`, so nothing is allocated and nothing
+ *      throws. Items that are not valid numbers (the whole item must be consumed)
+ *      are skipped. Use `try_parse` if you need to know about them.
+ *      The items must be convertible to `std::string_view`.
+ *      To get an iterator of this type, invoke `parse` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam T:            The type of the numbers
+ *
+ * @example:
+ * ```
+ * auto res = split("1,2,x,4", ',')
+ *      .parse<int>()
+ *      .collect<Array>();
+ *
+ * // res is: [1, 2, 4]
+ * ```
+ */
+template<typename IteratorType, typename T>
+struct Parse : public Iterator<T, Parse<IteratorType, T>> {
+  using ItemType = T;
+  using ValueRef = const internal::unwraped_item_type<IteratorType> &;
+
+  explicit Parse(IteratorType it) : inner{it} {}
+
+  std::optional<ItemType> next() {
+    for (auto v = inner.next(); v.has_value(); v = inner.next()) {
+      T value{};
+      if (internal::parse_number(std::string_view(static_cast<ValueRef>(*v)), value) == std::errc{}) {
+        return std::make_optional(value);
+      }
+    }
+    return std::nullopt;
+  }
+
+  IteratorType inner;
+};
+
+/**
+ * Summary:
+ *      Same as `Parse` but yields a `ParseResult<T>` for every item, which
+ *      holds either the number or the reason the item could not be parsed.
+ *      To get an iterator of this type, invoke `try_parse` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam T:            The type of the numbers
+ *
+ * @example:
+ * ```
+ * auto res = split("1,x", ',').try_parse<int>();
+ *
+ * // res.next()->value is 1
+ * // res.next()->error is std::errc::invalid_argument
+ * ```
+ */
+template<typename IteratorType, typename T>
+struct TryParse : public Iterator<ParseResult<T>, TryParse<IteratorType, T>> {
+  using ItemType = ParseResult<T>;
+  using ValueRef = const internal::unwraped_item_type<IteratorType> &;
+
+  explicit TryParse(IteratorType it) : inner{it} {}
+
+  std::optional<ItemType> next() {
+    auto v = inner.next();
+    if (v.has_value()) {
+      ItemType res{};
+      res.error = internal::parse_number(std::string_view(static_cast<ValueRef>(*v)), res.value);
+      return std::make_optional(res);
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  IteratorType inner;
+};
+
+/**
+ * Summary:
+ *      An iterator that maps items with a function that can fail, and stops at
+ *      the first failure. The function returns a `Result`, which the iterator yields.
+ *      After yielding an error, it yields nothing else, so nothing after the failed
+ *      item is computed. If the items are already `Result`s (e.g. from another
+ *      `try_map`), the function gets the values and the errors are passed through.
+ *      To get an iterator of this type, invoke `try_map` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam MapF:         The type of the function that performs the mapping
+ *
+ * @example:
+ * ```
+ * auto res = split("1,2,x,4", ',')
+ *      .try_map([](const std::string_view &token) -> Result<int, std::errc> {
+ *          int value;
+ *          auto [_, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+ *          if (error != std::errc{}) {
+ *              return Err{error};
+ *          }
+ *          return value;
+ *      })
+ *      .try_collect<Array>();
+ *
+ * // res.error() is std::errc::invalid_argument, "4" was never parsed
+ * ```
+ */
+template<typename IteratorType, typename MapF>
+struct TryMap : public Iterator<std::result_of_t<MapF(internal::try_arg_t<IteratorType>)>, TryMap<IteratorType, MapF>> {
+  using ItemType = std::result_of_t<MapF(internal::try_arg_t<IteratorType>)>;
+  using Input = internal::result_traits<internal::unwraped_item_type<IteratorType>>;
+
+  static_assert(internal::is_result_v<ItemType>, "The function must return a Result");
+
+  explicit TryMap(IteratorType it, MapF mapper) : inner{it}, mapper{mapper}, failed{false} {}
+
+  std::optional<ItemType> next() {
+    if (this->failed) {
+      return std::nullopt;
+    }
+    auto v = inner.next();
+    if (!v.has_value()) {
+      return std::nullopt;
+    }
+    if constexpr (Input::is_result) {
+      if (v->is_err()) {
+        this->failed = true;
+        return std::make_optional<ItemType>(Err{std::move(*v).error()});
+      }
+      ItemType res = mapper(v->value());
+      this->failed = res.is_err();
+      return std::make_optional(std::move(res));
+    } else {
+      ItemType res = mapper(*v);
+      this->failed = res.is_err();
+      return std::make_optional(std::move(res));
+    }
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    if (this->failed) {
+      return {0U, std::make_optional(0U)};
+    }
+    return {0U, inner.size_hint().second};
+  }
+
+  IteratorType inner;
+  MapF mapper;
+  bool failed;
+};
+
+/**
+ * Summary:
+ *      An iterator that filters items with a predicate that can fail, and stops at
+ *      the first failure. The predicate returns a `Result<bool, E>`. The iterator yields
+ *      the items the predicate kept as `Result`s, followed by the error if there is one.
+ *      If the items are already `Result`s, the predicate gets the values and the errors
+ *      are passed through.
+ *      To get an iterator of this type, invoke `try_filter` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam Predicate:    The type of the predicate
+ *
+ * @example:
+ * ```
+ * auto res = ids.iter()
+ *      .try_filter([&db](const int &id) -> Result<bool, DbError> {
+ *          auto row = db.lookup(id);
+ *          if (!row) {
+ *              return Err{row.error()};
+ *          }
+ *          return row->active;
+ *      })
+ *      .try_collect<Array>();
+ * ```
+ */
+template<typename IteratorType, typename Predicate>
+struct TryFilter : public Iterator<
+    std::conditional_t<internal::is_result_v<internal::unwraped_item_type<IteratorType>>,
+                       internal::item_type<IteratorType>,
+                       Result<internal::item_type<IteratorType>,
+                              typename std::result_of_t<Predicate(internal::try_arg_t<IteratorType>)>::ErrorType>>,
+    TryFilter<IteratorType, Predicate>> {
+  using Keep = std::result_of_t<Predicate(internal::try_arg_t<IteratorType>)>;
+  using Input = internal::result_traits<internal::unwraped_item_type<IteratorType>>;
+  using ItemType = std::conditional_t<Input::is_result, internal::item_type<IteratorType>,
+                                      Result<internal::item_type<IteratorType>, typename Keep::ErrorType>>;
+
+  static_assert(std::is_same_v<Keep, Result<bool, typename Keep::ErrorType>>,
+                "The predicate must return a Result<bool, E>");
+
+  TryFilter(IteratorType it, Predicate p) : inner{it}, predicate{p}, failed{false} {}
+
+  std::optional<ItemType> next() {
+    if (this->failed) {
+      return std::nullopt;
+    }
+    for (auto v = inner.next(); v.has_value(); v = inner.next()) {
+      if constexpr (Input::is_result) {
+        if (v->is_err()) {
+          this->failed = true;
+          return v;
+        }
+      }
+      Keep keep = [&]() {
+        if constexpr (Input::is_result) {
+          return predicate(v->value());
+        } else {
+          return predicate(*v);
+        }
+      }();
+      if (keep.is_err()) {
+        this->failed = true;
+        return std::make_optional<ItemType>(Err{std::move(keep).error()});
+      }
+      if (*keep) {
+        return std::make_optional<ItemType>(std::move(*v));
+      }
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    if (this->failed) {
+      return {0U, std::make_optional(0U)};
+    }
+    return {0U, inner.size_hint().second};
+  }
+
+  IteratorType inner;
+  Predicate predicate;
+  bool failed;
+};
+
+namespace internal {
+/**
+ * Summary:
+ *      Yields copies of the values of an iterator over `Result`s and stops
+ *      at the first error, which it stores in `error`. That's how `try_collect`
+ *      hands the values to `from_iterator` of a collection that knows
+ *      nothing about errors.
+ */
+template<typename IteratorType>
+struct ResultShunt : public Iterator<strip_ref_wrapper_t<typename result_traits<item_type<IteratorType>>::Value>,
+                                    ResultShunt<IteratorType>> {
+  using ItemType = strip_ref_wrapper_t<typename result_traits<item_type<IteratorType>>::Value>;
+  using ErrorType = typename result_traits<item_type<IteratorType>>::Error;
+
+  ResultShunt(IteratorType it, std::optional<ErrorType> *error) : inner{it}, error{error} {}
+
+  std::optional<ItemType> next() {
+    if (this->error->has_value()) {
+      return std::nullopt;
+    }
+    auto v = inner.next();
+    if (!v.has_value()) {
+      return std::nullopt;
+    }
+    if (v->is_err()) {
+      *this->error = std::move(*v).error();
+      return std::nullopt;
+    }
+    return std::make_optional(std::move(*v).value());
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    if (this->error->has_value()) {
+      return {0U, std::make_optional(0U)};
+    }
+    return {0U, inner.size_hint().second};
+  }
+
+  IteratorType inner;
+  std::optional<ErrorType> *error;
+};
+}
+
+/**
+ * Summary:
+ *      An iterator that prefetches the memory its items will need ahead of time.
+ *      It runs `distance` items ahead of the underlying iterator and, for every
+ *      item it reads ahead, issues a prefetch for the address returned by the
+ *      given function. By the time the item is yielded, its data is (hopefully)
+ *      already in the cache. That's useful when each item leads to a random
+ *      memory access, like looking it up in a big table.
+ *      Random access iterators are not buffered: the item `distance` ahead is
+ *      read by index instead. Otherwise the lookahead items are kept in a ring buffer.
+ *      To get an iterator of this type, invoke `prefetch` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator
+ * @tparam AddrF:        The type of the function that returns the address to prefetch for an item
+ *
+ * @example:
+ * ```
+ * Array<size_t> ids = ...;
+ * Array<Row> table = ...;
+ *
+ * auto total = ids.iter()
+ *      .prefetch(16, [&table](const size_t &id) { return &table[id]; })
+ *      .map([&table](const size_t &id) { return table[id].value; })
+ *      .sum();
+ * ```
+ */
+template<typename IteratorType, typename AddrF>
+struct Prefetch : public Iterator<internal::item_type<IteratorType>, Prefetch<IteratorType, AddrF>> {
+  using ItemType = internal::item_type<IteratorType>;
+
+  static constexpr bool is_random_access = internal::is_random_access_v<IteratorType>;
+
+  Prefetch(IteratorType it, size_t distance, AddrF addr)
+      : inner{it}, addr{addr}, distance{distance}, window{}, head{0U}, buffered{0U}, started{false} {}
+
+  std::optional<ItemType> next() {
+    if constexpr (is_random_access) {
+      if (inner.len() > distance) {
+        internal::prefetch(addr(inner[distance]));
+      }
+      return inner.next();
+    } else {
+      if (!started) {
+        started = true;
+        window.resize(distance + 1U);
+        while (buffered != distance && read_ahead()) {}
+      }
+
+      read_ahead();
+      if (buffered == 0U) {
+        return std::nullopt;
+      }
+
+      auto res = std::move(window[head]);
+      head = (head + 1U) % window.size();
+      --buffered;
+      return res;
+    }
+  }
+
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  [[nodiscard]] size_t len() const { return inner.len(); }
+
+  /**
+   * Summary:
+   *    Skips random access items directly, since there's nothing to prefetch for them
+   */
+  size_t advance_by(size_t n) {
+    if constexpr (is_random_access) {
+      return inner.advance_by(n);
+    } else {
+      return Iterator<ItemType, Prefetch<IteratorType, AddrF>>::advance_by(n);
+    }
+  }
+
+  size_t advance_read_by(size_t n) {
+    return inner.advance_read_by(n);
+  }
+
+  /**
+   * Summary:
+   *    Reads an item by index and prefetches the one `distance` items after it,
+   *    so that the loops that walk a random access pipeline by index (`for_each`,
+   *    `collect`, `zip_reduce`, `as_view`, ...) prefetch as well
+   */
+  template<typename It = IteratorType, typename = internal::enable_if_random_access_t<It>>
+  ItemType operator[](size_t index) const {
+    if (index + distance < inner.len()) {
+      internal::prefetch(addr(inner[index + distance]));
+    }
+    return inner[index];
+  }
+
+  IteratorType inner;
+  AddrF addr;
+  size_t distance;
+  std::vector<std::optional<ItemType>> window;
+  size_t head;
+  size_t buffered;
+  bool started;
+
+private:
+  bool read_ahead() {
+    auto v = inner.next();
+    if (!v.has_value()) {
+      return false;
+    }
+
+    internal::prefetch(addr(*v));
+    window[(head + buffered) % window.size()] = std::move(v);
+    ++buffered;
+    return true;
+  }
+};
+
+/**
+ * Summary:
+ *      An iterator that yields every pair of an item of the outer iterator with an
+ *      item of the inner iterator. The inner iterator is cloned once per outer item,
+ *      so it must be cheap to clone and must yield the same items every time.
+ *      When both iterators are random access, the product is itself random access
+ *      with an exact `len`.
+ *      The pairs come in lexicographic order: the first outer item with every inner
+ *      item, then the second one and so on. With `Blocked`, the product is walked in
+ *      blocks instead: every outer item is paired with the first block of inner items,
+ *      then every outer item with the next block and so on. A block is sized to fit in
+ *      the L1 cache, so the inner items stay there while they are paired with all the
+ *      outer items. The order is only lexicographic if the inner iterator fits in one block.
+ *      To get an iterator of this type, invoke `cartesian_product` (or
+ *      `cartesian_product_blocked`) method on an iterator.
+ *
+ * @tparam OuterIterator: The type of the outer iterator
+ * @tparam InnerIterator: The type of the inner iterator
+ * @tparam Blocked:       Whether to walk a random access product in blocks
+ *
+ * @example:
+ * ```
+ * Array<int> ints(2);
+ * ints[0] = 1;
+ * ints[1] = 2;
+ *
+ * Array<char> chars(2);
+ * chars[0] = 'a';
+ * chars[1] = 'b';
+ *
+ * auto pairs = ints.iter()
+ *      .cartesian_product(chars.iter())
+ *      .map([](std::pair<std::reference_wrapper<int>, std::reference_wrapper<char>> p) {
+ *          return std::make_pair(p.first.get(), p.second.get());
+ *      })
+ *      .collect<Array>();
+ *
+ * // pairs is: [(1, 'a'), (1, 'b'), (2, 'a'), (2, 'b')]
+ * ```
+ */
+template<typename OuterIterator, typename InnerIterator, bool Blocked = false>
+struct CartesianProduct : public Iterator<std::pair<internal::item_type<OuterIterator>,
+                                                    internal::item_type<InnerIterator>>,
+                                          CartesianProduct<OuterIterator, InnerIterator, Blocked>> {
+  using OuterItemType = internal::item_type<OuterIterator>;
+  using InnerItemType = internal::item_type<InnerIterator>;
+  using ItemType = std::pair<OuterItemType, InnerItemType>;
+
+  static constexpr bool is_random_access = internal::is_random_access_v<OuterIterator>
+      && internal::is_random_access_v<InnerIterator>;
+
+  static constexpr size_t BLOCK_BYTES = 16U * 1024U;
+
+  CartesianProduct(OuterIterator outer, InnerIterator inner)
+      : outer{outer}, inner_orig{inner}, inner{}, current{}, front{0U}, block{1U}, outer_pos{0U},
+        inner_pos{0U}, block_begin{0U}, block_end{0U} {
+    if constexpr (is_random_access) {
+      if constexpr (Blocked) {
+        constexpr size_t item_size = sizeof(internal::strip_ref_wrapper_t<InnerItemType>);
+        this->block = item_size < BLOCK_BYTES ? BLOCK_BYTES / item_size : 1U;
+      } else {
+        // One block that spans the whole inner side is the lexicographic order
+        this->block = inner_orig.len() != 0U ? inner_orig.len() : 1U;
+      }
+      locate(0U);
+    }
+  }
+
+  std::optional<ItemType> next() {
+    if constexpr (is_random_access) {
+      if (len() == 0U) {
+        return std::nullopt;
+      }
+
+      auto res = std::make_pair(outer[this->outer_pos], inner_orig[this->inner_pos]);
+      ++this->front;
+      if (++this->inner_pos == this->block_end) {
+        this->inner_pos = this->block_begin;
+        if (++this->outer_pos == outer.len()) {
+          this->outer_pos = 0U;
+          this->block_begin = this->block_end;
+          this->block_end = this->block_end + this->block < inner_orig.len()
+              ? this->block_end + this->block : inner_orig.len();
+          this->inner_pos = this->block_begin;
+        }
+      }
+      return std::make_optional(res);
+    } else {
+      while (true) {
+        if (!this->current.has_value()) {
+          this->current = outer.next();
+          if (!this->current.has_value()) {
+            return std::nullopt;
+          }
+          inner.emplace(inner_orig);
+        }
+
+        auto v = inner->next();
+        if (v.has_value()) {
+          return std::make_optional(std::make_pair(*this->current, *v));
+        }
+        this->current.reset();
+      }
+    }
+  }
+
+  template<typename Outer = OuterIterator, typename Inner = InnerIterator,
+      typename = internal::enable_if_random_access_t<Outer, Inner>>
+  [[nodiscard]] size_t len() const { return outer.len() * inner_orig.len() - this->front; }
+
+  template<typename Outer = OuterIterator, typename Inner = InnerIterator,
+      typename = internal::enable_if_random_access_t<Outer, Inner>>
+  ItemType operator[](size_t index) const {
+    const auto[o, i] = position(this->front + index);
+    return std::make_pair(outer[o], inner_orig[i]);
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    if constexpr (is_random_access) {
+      return std::make_pair(len(), std::make_optional(len()));
+    } else {
+      const auto[outer_lo, outer_hi] = outer.size_hint();
+      const auto[inner_lo, inner_hi] = inner_orig.size_hint();
+      size_t current_lo = 0U;
+      std::optional<size_t> current_hi = 0U;
+      if (this->current.has_value()) {
+        std::tie(current_lo, current_hi) = inner->size_hint();
+      }
+
+      std::optional<size_t> hi{};
+      if (outer_hi.has_value() && inner_hi.has_value() && current_hi.has_value()) {
+        hi = *outer_hi * *inner_hi + *current_hi;
+      }
+      return std::make_pair(outer_lo * inner_lo + current_lo, hi);
+    }
+  }
+
+  size_t advance_by(size_t n) {
+    if constexpr (is_random_access) {
+      const size_t advanced = n < len() ? n : len();
+      locate(this->front + advanced);
+      return advanced;
+    } else {
+      return Iterator<ItemType, CartesianProduct<OuterIterator, InnerIterator, Blocked>>::advance_by(n);
+    }
+  }
+
+  OuterIterator outer;
+  InnerIterator inner_orig;
+  // The pass over the inner items for the current outer item. It's rebuilt from
+  // `inner_orig` with `emplace`, since adapters that hold lambdas can't be assigned.
+  std::optional<InnerIterator> inner;
+  std::optional<OuterItemType> current;
+
+  // The state of the random access iteration
+  size_t front;
+  size_t block;
+  size_t outer_pos;
+  size_t inner_pos;
+  size_t block_begin;
+  size_t block_end;
+
+private:
+  /**
+   * Summary:
+   *    Maps the index of a pair, in block order, to the
+   *    indexes of the outer and the inner items
+   */
+  [[nodiscard]] std::pair<size_t, size_t> position(size_t index) const {
+    const size_t block_items = outer.len() * this->block;
+    const size_t begin = index / block_items * this->block;
+    const size_t width = begin + this->block < inner_orig.len() ? this->block : inner_orig.len() - begin;
+    const size_t offset = index % block_items;
+    return std::make_pair(offset / width, begin + offset % width);
+  }
+
+  void locate(size_t index) {
+    this->front = index;
+    if (outer.len() == 0U || inner_orig.len() == 0U || index == outer.len() * inner_orig.len()) {
+      this->block_begin = this->block_end = inner_orig.len();
+      return;
+    }
+
+    std::tie(this->outer_pos, this->inner_pos) = position(index);
+    this->block_begin = this->inner_pos / this->block * this->block;
+    this->block_end = this->block_begin + this->block < inner_orig.len()
+        ? this->block_begin + this->block : inner_orig.len();
+  }
+};
+
+namespace internal {
+/**
+ * Summary:
+ *      The number of ways to choose `k` out of `n` items without order and repetition
+ */
+constexpr size_t binomial(size_t n, size_t k) {
+  if (k > n) {
+    return 0U;
+  }
+  if (k > n - k) {
+    k = n - k;
+  }
+  size_t res = 1U;
+  for (size_t i = 0U; i != k; ++i) {
+    // res * (n - i) / (i + 1) is exact, split so that it doesn't overflow needlessly
+    res = res / (i + 1U) * (n - i) + res % (i + 1U) * (n - i) / (i + 1U);
+  }
+  return res;
+}
+}
+
+/**
+ * Summary:
+ *      An iterator that yields every `k` items long combination of the items of a random
+ *      access iterator, in lexicographic order of their positions. The combination is
+ *      yielded as a reference to a buffer that the iterator reuses, so it's only valid
+ *      until the next call to `next`. The buffer and the positions are allocated once,
+ *      when the iterator is created.
+ *      To get an iterator of this type, invoke `combinations` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator. It must be random access
+ *
+ * @example:
+ * ```
+ * Array<int> ints(3);
+ * ints[0] = 1;
+ * ints[1] = 2;
+ * ints[2] = 3;
+ *
+ * auto sums = ints.iter()
+ *      .combinations(2)
+ *      .map([](const std::vector<std::reference_wrapper<int>> &c) { return c[0] + c[1]; })
+ *      .collect<Array>();
+ *
+ * // The combinations are: [1, 2], [1, 3], [2, 3]
+ * // sums is: [3, 4, 5]
+ * ```
+ */
+template<typename IteratorType>
+struct Combinations : public Iterator<std::reference_wrapper<const std::vector<internal::item_type<IteratorType>>>,
+                                      Combinations<IteratorType>> {
+  static_assert(internal::is_random_access_v<IteratorType>, "Combinations need a random access iterator");
+
+  using SourceItemType = internal::item_type<IteratorType>;
+  using ItemType = std::reference_wrapper<const std::vector<SourceItemType>>;
+
+  Combinations(IteratorType it, size_t k)
+      : source{it}, positions(k), buffer{}, remaining{internal::binomial(it.len(), k)}, started{false} {
+    for (size_t i = 0U; i != k; ++i) {
+      this->positions[i] = i;
+    }
+    this->buffer.reserve(k);
+  }
+
+  std::optional<ItemType> next() {
+    if (this->remaining == 0U) {
+      return std::nullopt;
+    }
+
+    if (this->started) {
+      // Find the rightmost position that can still move right, move it
+      // and put the positions after it right next to it
+      const size_t n = source.len();
+      const size_t k = this->positions.size();
+      size_t i = k - 1U;
+      while (this->positions[i] == i + n - k) {
+        --i;
+      }
+      ++this->positions[i];
+      for (size_t j = i + 1U; j != k; ++j) {
+        this->positions[j] = this->positions[j - 1U] + 1U;
+      }
+    }
+    this->started = true;
+    --this->remaining;
+
+    this->buffer.clear();
+    for (size_t position : this->positions) {
+      this->buffer.push_back(source[position]);
+    }
+    return std::make_optional(std::cref(this->buffer));
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->remaining; }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  IteratorType source;
+  std::vector<size_t> positions;
+  std::vector<SourceItemType> buffer;
+  size_t remaining;
+  bool started;
+};
+
+/**
+ * Summary:
+ *      Like `Combinations`, but an item can be picked more than once.
+ *      The positions of a combination never decrease.
+ *      To get an iterator of this type, invoke `combinations_with_replacement`
+ *      method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator. It must be random access
+ *
+ * @example:
+ * ```
+ * Array<char> chars(2);
+ * chars[0] = 'a';
+ * chars[1] = 'b';
+ *
+ * // Yields: [a, a], [a, b], [b, b]
+ * chars.iter().combinations_with_replacement(2);
+ * ```
+ */
+template<typename IteratorType>
+struct CombinationsWithReplacement
+    : public Iterator<std::reference_wrapper<const std::vector<internal::item_type<IteratorType>>>,
+                      CombinationsWithReplacement<IteratorType>> {
+  static_assert(internal::is_random_access_v<IteratorType>,
+                "Combinations with replacement need a random access iterator");
+
+  using SourceItemType = internal::item_type<IteratorType>;
+  using ItemType = std::reference_wrapper<const std::vector<SourceItemType>>;
+
+  CombinationsWithReplacement(IteratorType it, size_t k)
+      : source{it}, positions(k, 0U), buffer{},
+        remaining{it.len() == 0U ? (k == 0U ? 1U : 0U) : internal::binomial(it.len() + k - 1U, k)},
+        started{false} {
+    this->buffer.reserve(k);
+  }
+
+  std::optional<ItemType> next() {
+    if (this->remaining == 0U) {
+      return std::nullopt;
+    }
+
+    if (this->started) {
+      // Find the rightmost position that is not at the last item, move it
+      // and put all the positions after it on the same item
+      const size_t last = source.len() - 1U;
+      size_t i = this->positions.size() - 1U;
+      while (this->positions[i] == last) {
+        --i;
+      }
+      const size_t position = this->positions[i] + 1U;
+      for (size_t j = i; j != this->positions.size(); ++j) {
+        this->positions[j] = position;
+      }
+    }
+    this->started = true;
+    --this->remaining;
+
+    this->buffer.clear();
+    for (size_t position : this->positions) {
+      this->buffer.push_back(source[position]);
+    }
+    return std::make_optional(std::cref(this->buffer));
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->remaining; }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  IteratorType source;
+  std::vector<size_t> positions;
+  std::vector<SourceItemType> buffer;
+  size_t remaining;
+  bool started;
+};
+
+/**
+ * Summary:
+ *      An iterator that yields every `k` items long permutation of the items of a
+ *      random access iterator, in lexicographic order of their positions.
+ *      Like `Combinations`, the permutation is yielded as a reference to a reused
+ *      buffer that is only valid until the next call to `next`.
+ *      To get an iterator of this type, invoke `permutations` method on an iterator.
+ *
+ * @tparam IteratorType: The type of the underlying iterator. It must be random access
+ *
+ * @example:
+ * ```
+ * Array<int> ints(3);
+ * ints[0] = 1;
+ * ints[1] = 2;
+ * ints[2] = 3;
+ *
+ * // Yields: [1, 2], [1, 3], [2, 1], [2, 3], [3, 1], [3, 2]
+ * ints.iter().permutations(2);
+ * ```
+ */
+template<typename IteratorType>
+struct Permutations : public Iterator<std::reference_wrapper<const std::vector<internal::item_type<IteratorType>>>,
+                                      Permutations<IteratorType>> {
+  static_assert(internal::is_random_access_v<IteratorType>, "Permutations need a random access iterator");
+
+  using SourceItemType = internal::item_type<IteratorType>;
+  using ItemType = std::reference_wrapper<const std::vector<SourceItemType>>;
+
+  Permutations(IteratorType it, size_t k)
+      : source{it}, positions(it.len()), cycles(k <= it.len() ? k : 0U), buffer{}, remaining{0U}, started{false} {
+    const size_t n = it.len();
+    for (size_t i = 0U; i != n; ++i) {
+      this->positions[i] = i;
+    }
+    if (k <= n) {
+      this->remaining = 1U;
+      for (size_t i = 0U; i != k; ++i) {
+        this->cycles[i] = n - i;
+        this->remaining *= n - i;
+      }
+    }
+    this->buffer.reserve(k);
+  }
+
+  std::optional<ItemType> next() {
+    if (this->remaining == 0U) {
+      return std::nullopt;
+    }
+
+    if (this->started) {
+      advance();
+    }
+    this->started = true;
+    --this->remaining;
+
+    this->buffer.clear();
+    for (size_t i = 0U; i != this->cycles.size(); ++i) {
+      this->buffer.push_back(source[this->positions[i]]);
+    }
+    return std::make_optional(std::cref(this->buffer));
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->remaining; }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  IteratorType source;
+  std::vector<size_t> positions;
+  // cycles[i] is how many more items position `i` will take before it's reset
+  std::vector<size_t> cycles;
+  std::vector<SourceItemType> buffer;
+  size_t remaining;
+  bool started;
+
+private:
+  void advance() {
+    const size_t n = this->positions.size();
+    for (size_t i = this->cycles.size(); i-- != 0U;) {
+      if (--this->cycles[i] == 0U) {
+        std::rotate(this->positions.begin() + i, this->positions.begin() + i + 1, this->positions.end());
+        this->cycles[i] = n - i;
+      } else {
+        std::swap(this->positions[i], this->positions[n - this->cycles[i]]);
+        return;
+      }
+    }
+  }
+};
+
+/**
+ * Summary:
+ *      That's the heart of the iterator.
+ *      It's a base class which uses CRTP (Curiously Recurring Template Pattern)
+ *      to automatically implement all the iterator methods for a user defined
+ *      iterator. It defines all the methods an iterator can have. All methods
+ *      make use of the `next` method which is the only method you will need to
+ *      implement. Everything else is already implemented. However, if you can
+ *      provide a better implementation for some of the methods, then you can shadow
+ *      the methods here by reimplementing them in the specific iterator type.
+ *      What you need to provide when implementing an iterator is the type of the item
+ *      that the iterator will yield (for references use std::reference_wrapper<T>).
+ *      This type must be supplied when inheriting from the `Iterator` type as well
+ *      as as a member type of your iterator. Also you need to implement the `next`
+ *      method.
+ *
+ *      e.g:
+ *      template<typename T>
+ *      struct MyCollection {
+ *          // In place of T in specialization below, pass std::reference_wrapper<T>
+ *          // to yield by reference
+ *          struct MyCollectionIterator : public Iterator<T, MyCollectionIterator> {
+ *              using ItemType = T; // That's by value yielding. It will cause copy construction/assignment
+ *              // using ItemType = std::reference_wrapper<T> if you want to yield by reference
+ *
+ *              std::optional<ItemType> next() { ... }
+ *          };
+ *      };
+ *
+ * @tparam ItemType:     The type of the item that the iterator will yield
+ * @tparam IteratorType: The type of the iterator that is implementing the functionality
+ */
+template<typename ItemType, typename IteratorType>
+struct Iterator {
+  /**
+   * Summary:
+   *    Creates a `StepBy` iterator with given `step`
+   *
+   * @param step: The amount of stepping to perform
+   * @return: A `StepBy` iterator
+   */
+  [[nodiscard]]
+  StepBy<IteratorType> step_by(size_t step) {
     auto *it = static_cast<IteratorType *>(this);
     return StepBy<IteratorType>(*it, step);
   }
@@ -1111,6 +2649,197 @@ struct Iterator {
     return UniqueBy<IteratorType, F>(*it, func);
   }
 
+  /**
+   * Summary:
+   *    Creates an `Rle` iterator
+   *
+   * @return: An `Rle` iterator
+   */
+  Rle<IteratorType> rle() {
+    auto *it = static_cast<IteratorType *>(this);
+    return Rle<IteratorType>(*it);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `CartesianProduct` iterator given an inner iterator
+   *
+   * @tparam InnerIterator: The type of the inner iterator
+   * @param other:          The inner iterator, which is cloned for every item of this one
+   * @return:               A `CartesianProduct` iterator
+   */
+  template<typename InnerIterator>
+  CartesianProduct<IteratorType, InnerIterator> cartesian_product(InnerIterator other) {
+    auto *it = static_cast<IteratorType *>(this);
+    return CartesianProduct<IteratorType, InnerIterator>(*it, other);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `CartesianProduct` iterator that walks the product in cache sized
+   *    blocks of the inner items. Both iterators must be random access.
+   *    The pairs are the same as the ones of `cartesian_product`, but once the
+   *    inner iterator is larger than a block they don't come in lexicographic order.
+   *
+   * @tparam InnerIterator: The type of the inner iterator
+   * @param other:          The inner iterator
+   * @return:               A blocked `CartesianProduct` iterator
+   */
+  template<typename InnerIterator>
+  CartesianProduct<IteratorType, InnerIterator, true> cartesian_product_blocked(InnerIterator other) {
+    static_assert(internal::is_random_access_v<IteratorType> && internal::is_random_access_v<InnerIterator>,
+                  "cartesian_product_blocked needs random access iterators");
+    auto *it = static_cast<IteratorType *>(this);
+    return CartesianProduct<IteratorType, InnerIterator, true>(*it, other);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `Combinations` iterator that yields every `k` items long
+   *    combination of the items. The iterator must be random access.
+   *
+   * @param k: The number of items of each combination
+   * @return:  A `Combinations` iterator
+   */
+  Combinations<IteratorType> combinations(size_t k) {
+    auto *it = static_cast<IteratorType *>(this);
+    return Combinations<IteratorType>(*it, k);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `CombinationsWithReplacement` iterator that yields every `k` items
+   *    long combination of the items, where an item can be picked more than once.
+   *    The iterator must be random access.
+   *
+   * @param k: The number of items of each combination
+   * @return:  A `CombinationsWithReplacement` iterator
+   */
+  CombinationsWithReplacement<IteratorType> combinations_with_replacement(size_t k) {
+    auto *it = static_cast<IteratorType *>(this);
+    return CombinationsWithReplacement<IteratorType>(*it, k);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `Permutations` iterator that yields every `k` items long
+   *    permutation of the items. The iterator must be random access.
+   *
+   * @param k: The number of items of each permutation
+   * @return:  A `Permutations` iterator
+   */
+  Permutations<IteratorType> permutations(size_t k) {
+    auto *it = static_cast<IteratorType *>(this);
+    return Permutations<IteratorType>(*it, k);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `Prefetch` iterator given a lookahead distance and
+   *    a function that returns the address to prefetch for an item
+   *
+   * @tparam AddrF:   The type of the address function
+   * @param distance: How many items ahead to prefetch
+   * @param addr:     The address function
+   * @return:         A `Prefetch` iterator
+   */
+  template<typename AddrF>
+  Prefetch<IteratorType, AddrF> prefetch(size_t distance, AddrF addr) {
+    auto *it = static_cast<IteratorType *>(this);
+    return Prefetch<IteratorType, AddrF>(*it, distance, addr);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `Rev` iterator. The iterator must implement `next_back`
+   *
+   * @return: A `Rev` iterator
+   */
+  Rev<IteratorType> rev() {
+    auto *it = static_cast<IteratorType *>(this);
+    return Rev<IteratorType>(*it);
+  }
+
+  /**
+   * Summary:
+   *    Creates an `Intern` iterator given an interner
+   *
+   * @tparam Interner: The type of the interner
+   * @param interner:  The interner that will own the strings
+   * @return:          An `Intern` iterator
+   */
+  template<typename Interner>
+  Intern<IteratorType, Interner> intern(Interner &interner) {
+    auto *it = static_cast<IteratorType *>(this);
+    return Intern<IteratorType, Interner>(*it, interner);
+  }
+
+  /**
+   * Summary:
+   *    Creates an `InternIds` iterator given an interner
+   *
+   * @tparam Interner: The type of the interner
+   * @param interner:  The interner that will own the strings
+   * @return:          An `InternIds` iterator
+   */
+  template<typename Interner>
+  InternIds<IteratorType, Interner> intern_ids(Interner &interner) {
+    auto *it = static_cast<IteratorType *>(this);
+    return InternIds<IteratorType, Interner>(*it, interner);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `Parse` iterator
+   *
+   * @tparam T: The type of the numbers to parse
+   * @return:   A `Parse` iterator
+   */
+  template<typename T>
+  Parse<IteratorType, T> parse() {
+    auto *it = static_cast<IteratorType *>(this);
+    return Parse<IteratorType, T>(*it);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `TryParse` iterator
+   *
+   * @tparam T: The type of the numbers to parse
+   * @return:   A `TryParse` iterator
+   */
+  template<typename T>
+  TryParse<IteratorType, T> try_parse() {
+    auto *it = static_cast<IteratorType *>(this);
+    return TryParse<IteratorType, T>(*it);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `TryMap` iterator
+   *
+   * @param mapper: The function that maps the items, which returns a `Result`
+   * @return:       A `TryMap` iterator
+   */
+  template<typename MapF>
+  TryMap<IteratorType, MapF> try_map(MapF mapper) {
+    auto *it = static_cast<IteratorType *>(this);
+    return TryMap<IteratorType, MapF>(*it, mapper);
+  }
+
+  /**
+   * Summary:
+   *    Creates a `TryFilter` iterator
+   *
+   * @param p: The predicate, which returns a `Result<bool, E>`
+   * @return:  A `TryFilter` iterator
+   */
+  template<typename Predicate>
+  TryFilter<IteratorType, Predicate> try_filter(Predicate p) {
+    auto *it = static_cast<IteratorType *>(this);
+    return TryFilter<IteratorType, Predicate>(*it, p);
+  }
+
   using UnwrapedItemType = internal::unwrap_ref_wrapper_t<ItemType>;
 
   /**
@@ -1234,18 +2963,57 @@ struct Iterator {
       }
     }
 
-    return true;
+    return true;
+  }
+
+  /**
+   * Summary:
+   *    Consumes the iterator and tests each item against the given
+   *    predicate. If the predicate returns true, then the item is
+   *    found and returned.
+   *
+   * @tparam Predicate: The type of the predicate
+   * @param p:          The predicate to test
+   * @return:           The first item that matches the predicate, std::nullopt otherwise
+   *
+   * @example:
+   * ```
+   * Array<int> ints(5);
+   * for (size_t i = 0U; i != ints.len(); ++i) {
+   *    ints[i] = (int) i + 1;
+   * }
+   *
+   * // ints is: [1, 2, 3, 4, 5]
+   *
+   * auto v = ints.iter().find([](const int &v) { return v == 4; });
+   *
+   * assert(v.has_value());
+   * // v.value() is 4
+   * ```
+   */
+  template<typename Predicate>
+  std::optional<ItemType> find(Predicate p) {
+    ASSERT_RETURNS_BOOL(Predicate, UnwrapedItemType);
+
+    auto *iter = static_cast<IteratorType *>(this);
+    for (UnwrapedItemType v : *iter) {
+      if (p(v)) {
+        return v;
+      }
+    }
+
+    return std::nullopt;
   }
 
   /**
    * Summary:
-   *    Consumes the iterator and tests each item against the given
-   *    predicate. If the predicate returns true, then the item is
-   *    found and returned.
+   *    Consumes the iterator until an item matches the given predicate
+   *    and returns the (zero based) index of that item. It's what
+   *    `enumerate().find(...)` does, without building a pair for every item.
    *
    * @tparam Predicate: The type of the predicate
    * @param p:          The predicate to test
-   * @return:           The first item that matches the predicate, std::nullopt otherwise
+   * @return:           The index of the first item that matches the predicate, std::nullopt otherwise
    *
    * @example:
    * ```
@@ -1256,26 +3024,105 @@ struct Iterator {
    *
    * // ints is: [1, 2, 3, 4, 5]
    *
-   * auto v = ints.iter().find([](const int &v) { return v == 4; });
+   * auto index = ints.iter().position([](const int &v) { return v > 3; });
    *
-   * assert(v.has_value());
-   * // v.value() is 4
+   * // index.value() is 3
    * ```
    */
   template<typename Predicate>
-  std::optional<ItemType> find(Predicate p) {
+  std::optional<size_t> position(Predicate p) {
     ASSERT_RETURNS_BOOL(Predicate, UnwrapedItemType);
 
     auto *iter = static_cast<IteratorType *>(this);
-    for (UnwrapedItemType v : *iter) {
-      if (p(v)) {
-        return v;
+    for (size_t index = 0U;; ++index) {
+      auto v = iter->next();
+      if (!v.has_value()) {
+        return std::nullopt;
+      }
+      if (p(static_cast<UnwrapedItemType>(*v))) {
+        return std::make_optional(index);
+      }
+    }
+  }
+
+  /**
+   * Summary:
+   *    Consumes the iterator from the back until an item matches the given
+   *    predicate and returns the index of that item, counted from the front.
+   *    The iterator must implement `next_back`. Searching from the back needs
+   *    the exact length, through `len` or an exact `size_hint`. Without it, the
+   *    whole iterator is consumed from the front to count the indexes.
+   *
+   * @tparam Predicate: The type of the predicate
+   * @param p:          The predicate to test
+   * @return:           The index of the last item that matches the predicate, std::nullopt otherwise
+   *
+   * @example:
+   * ```
+   * std::string_view line = "key=value=more";
+   *
+   * auto last_eq = iter_from(line.data(), line.size())
+   *      .rposition([](const char &c) { return c == '='; });
+   *
+   * // last_eq.value() is 9
+   * ```
+   */
+  template<typename Predicate>
+  std::optional<size_t> rposition(Predicate p) {
+    ASSERT_RETURNS_BOOL(Predicate, UnwrapedItemType);
+
+    auto *iter = static_cast<IteratorType *>(this);
+    size_t index;
+    if constexpr (internal::is_random_access_v<IteratorType>) {
+      index = iter->len();
+    } else {
+      const auto[lower, upper] = iter->size_hint();
+      if (!upper.has_value() || *upper != lower) {
+        std::optional<size_t> last{};
+        size_t i = 0U;
+        for (auto v = iter->next(); v.has_value(); v = iter->next(), ++i) {
+          if (p(static_cast<UnwrapedItemType>(*v))) {
+            last = i;
+          }
+        }
+        return last;
       }
+      index = lower;
     }
 
+    for (auto v = iter->next_back(); v.has_value(); v = iter->next_back()) {
+      --index;
+      if (p(static_cast<UnwrapedItemType>(*v))) {
+        return std::make_optional(index);
+      }
+    }
     return std::nullopt;
   }
 
+  /**
+   * Summary:
+   *    Consumes the iterator until an item is equal to `value`
+   *    and returns the index of that item. Iterators over contiguous
+   *    memory (like `Array::iter`) shadow this method with a search
+   *    that compares many items at a time (see `internal::find_value`).
+   *
+   * @param value: The value to look for
+   * @return:      The index of the first item equal to `value`, std::nullopt otherwise
+   *
+   * @example:
+   * ```
+   * Array<char> line = ...; // "GET /index.html"
+   *
+   * auto space = line.iter().position_of(' ');
+   *
+   * // space.value() is 3
+   * ```
+   */
+  template<typename U>
+  std::optional<size_t> position_of(const U &value) {
+    return position([&value](UnwrapedItemType v) { return v == value; });
+  }
+
   /**
    * Summary:
    *    Consumes the iterator and returns the maximum element.
@@ -1419,12 +3266,125 @@ struct Iterator {
    */
   template<typename F>
   void for_each(F func) {
-    auto iter = *static_cast<IteratorType *>(this);
-    for (UnwrapedItemType v : iter) {
-      func(v);
+    auto *iter = static_cast<IteratorType *>(this);
+    if constexpr (internal::is_random_access_v<IteratorType>) {
+      // Indexing lets the compiler see a counted loop, which it can vectorise
+      const size_t len = iter->len();
+      for (size_t i = 0U; i != len; ++i) {
+        func(static_cast<UnwrapedItemType>((*iter)[i]));
+      }
+      iter->advance_read_by(len);
+    } else {
+      for (auto v = iter->next(); v.has_value(); v = iter->next()) {
+        func(static_cast<UnwrapedItemType>(*v));
+      }
+    }
+  }
+
+  /**
+   * Summary:
+   *    Consumes the iterator and applies the given function to each item
+   *    until the function returns `ControlFlow::Break` or an error. The items
+   *    after the one that stopped the loop are not consumed.
+   *    The function returns either a `ControlFlow` or a `Result`, whose value
+   *    is ignored and whose error stops the loop.
+   *
+   * @tparam F:   The type of the function to apply
+   * @param func: The function to apply, which tells whether to continue or to stop
+   * @return:     For a `ControlFlow`, `ControlFlow::Break` if the function broke the loop,
+   *              `ControlFlow::Continue` otherwise. For a `Result`, the first error if there is one.
+   *
+   * @example:
+   * ```
+   * Array<std::string> lines = ...;
+   *
+   * auto flow = lines.iter().try_for_each([&](const std::string &line) {
+   *     if (line.empty()) {
+   *         return ControlFlow::Break;
+   *     }
+   *     headers.push_back(line);
+   *     return ControlFlow::Continue;
+   * });
+   *
+   * std::optional<std::errc> error = lines.iter().try_for_each(
+   *     [&](const std::string &line) -> Result<size_t, std::errc> {
+   *         return file.write(line);
+   *     });
+   * ```
+   */
+  template<typename F>
+  auto try_for_each(F func) {
+    using Res = std::result_of_t<F(UnwrapedItemType)>;
+    static_assert(std::is_same_v<Res, ControlFlow> || internal::is_result_v<Res>,
+                  "Function must return a ControlFlow or a Result");
+
+    if constexpr (internal::is_result_v<Res>) {
+      std::optional<typename internal::result_traits<Res>::Error> error{};
+      try_for_each([&func, &error](UnwrapedItemType v) {
+        Res res = func(std::forward<UnwrapedItemType>(v));
+        if (res.is_err()) {
+          error = std::move(res).error();
+          return ControlFlow::Break;
+        }
+        return ControlFlow::Continue;
+      });
+      return error;
+    } else {
+      auto *iter = static_cast<IteratorType *>(this);
+      if constexpr (internal::is_random_access_v<IteratorType>) {
+        const size_t len = iter->len();
+        for (size_t i = 0U; i != len; ++i) {
+          if (func(static_cast<UnwrapedItemType>((*iter)[i])) == ControlFlow::Break) {
+            iter->advance_read_by(i + 1U);
+            return ControlFlow::Break;
+          }
+        }
+        iter->advance_read_by(len);
+      } else {
+        for (auto v = iter->next(); v.has_value(); v = iter->next()) {
+          if (func(static_cast<UnwrapedItemType>(*v)) == ControlFlow::Break) {
+            return ControlFlow::Break;
+          }
+        }
+      }
+      return ControlFlow::Continue;
     }
   }
 
+  /**
+   * Summary:
+   *    Consumes the iterator and applies the given predicate to each item
+   *    for as long as it returns true. It's `try_for_each` for functions that
+   *    return bool.
+   *
+   * @tparam Predicate: The type of the predicate
+   * @param p:          The predicate to apply
+   * @return:           true if the predicate returned true for all the items, false otherwise
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...;
+   * int budget = 100;
+   *
+   * // Spends the budget on the items in order, until it runs out
+   * ints.iter().for_each_while([&budget](const int &cost) {
+   *     if (cost > budget) {
+   *         return false;
+   *     }
+   *     budget -= cost;
+   *     return true;
+   * });
+   * ```
+   */
+  template<typename Predicate>
+  bool for_each_while(Predicate p) {
+    ASSERT_RETURNS_BOOL(Predicate, UnwrapedItemType);
+
+    return try_for_each([&p](UnwrapedItemType v) {
+      return p(v) ? ControlFlow::Continue : ControlFlow::Break;
+    }) == ControlFlow::Continue;
+  }
+
   using StrippedItemType = internal::strip_ref_wrapper_t<ItemType>;
 
   /**
@@ -1462,11 +3422,18 @@ struct Iterator {
    *    items yielded using a provided function.
    *    It takes an initial state that it will fold on and the function
    *    takes as input the running folded value and an iterator element.
-   *
-   * @tparam F:   The type of the function that performs the fold
-   * @param init: The initial value to perform the fold on
-   * @param func: The function that performs the fold
-   * @return:     A single value produced by folding all the values
+   *    The accumulator can be of any type; it's the type that the function
+   *    returns. It is moved into the function at every step, so a function that
+   *    takes it by value and returns it accumulates into a string or a container
+   *    without copying it. If the function can't take the initial value as is
+   *    (e.g. an `int` for a `double &`), the accumulator is the item type,
+   *    built from the initial value.
+   *
+   * @tparam Init: The type of the initial value
+   * @tparam F:    The type of the function that performs the fold
+   * @param init:  The initial value to perform the fold on
+   * @param func:  The function that performs the fold
+   * @return:      A single value produced by folding all the values
    *
    * @example:
    * ```
@@ -1481,21 +3448,199 @@ struct Iterator {
    *    });
    *
    * // product is 6 (1 * 2 * 3)
+   *
+   * Array<std::string> words = ...;
+   *
+   * std::string csv = words.iter()
+   *    .fold(std::string{}, [](std::string acc, const std::string &w) {
+   *        acc += w;
+   *        acc += ',';
+   *        return acc;
+   *    });
    * ```
    */
-  template<typename F>
-  StrippedItemType fold(StrippedItemType init, F func) {
-    static_assert(internal::returns_type_v<StrippedItemType, F, StrippedItemType &, UnwrapedItemType>,
+  template<typename Init, typename F>
+  auto fold(Init init, F func) {
+    using Acc = internal::fold_acc_t<F, Init, UnwrapedItemType, StrippedItemType>;
+    static_assert(std::is_constructible_v<Acc, Init &&>,
                   "Function must take an ItemType and an accumulator and must return the newly accumulated value");
 
     auto *iter = static_cast<IteratorType *>(this);
-    StrippedItemType res = init;
-    for (UnwrapedItemType v : *iter) {
-      res = func(res, v);
+    Acc res(std::move(init));
+    for (auto v = iter->next(); v.has_value(); v = iter->next()) {
+      res = internal::call_folder(func, res, static_cast<UnwrapedItemType>(*v));
     }
     return res;
   }
 
+  /**
+   * Summary:
+   *    Consumes the iterator and folds the items with the given function,
+   *    using the first item as the initial value
+   *
+   * @tparam F:   The type of the function that combines two items
+   * @param func: The function that combines the running value with the next item
+   * @return:     The reduced value, std::nullopt if the iterator is empty
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...; // [3, 1, 2]
+   *
+   * auto max = ints.iter().reduce([](int acc, const int &v) { return acc > v ? acc : v; });
+   *
+   * // max.value() is 3
+   * ```
+   */
+  template<typename F>
+  std::optional<StrippedItemType> reduce(F func) {
+    auto *iter = static_cast<IteratorType *>(this);
+    auto first = iter->next();
+    if (!first.has_value()) {
+      return std::nullopt;
+    }
+
+    StrippedItemType res(static_cast<UnwrapedItemType>(*first));
+    for (auto v = iter->next(); v.has_value(); v = iter->next()) {
+      res = internal::call_folder(func, res, static_cast<UnwrapedItemType>(*v));
+    }
+    return std::make_optional(std::move(res));
+  }
+
+  /**
+   * Summary:
+   *    Like `fold`, but the function returns an `std::optional` of the accumulator
+   *    (or anything else that converts to bool and dereferences to it, like a `Result`)
+   *    and the fold stops at the first empty one. The items after it are not consumed.
+   *
+   * @tparam Init: The type of the initial value
+   * @tparam F:    The type of the function that performs the fold
+   * @param init:  The initial value to perform the fold on
+   * @param func:  The function that performs the fold
+   * @return:      The folded value, or the first empty value that the function returned
+   *
+   * @example:
+   * ```
+   * Array<int> ints = ...;
+   *
+   * // Sums the items unless the sum overflows
+   * auto sum = ints.iter()
+   *    .try_fold(0, [](int acc, const int &v) -> std::optional<int> {
+   *        int res;
+   *        if (__builtin_add_overflow(acc, v, &res)) {
+   *            return std::nullopt;
+   *        }
+   *        return res;
+   *    });
+   * ```
+   */
+  template<typename Init, typename F>
+  auto try_fold(Init init, F func) {
+    using Res = internal::fold_result_t<F, Init, UnwrapedItemType>;
+    using Acc = std::decay_t<decltype(*std::declval<Res &>())>;
+
+    auto *iter = static_cast<IteratorType *>(this);
+    Acc acc(std::move(init));
+    for (auto v = iter->next(); v.has_value(); v = iter->next()) {
+      Res res = internal::call_folder(func, acc, static_cast<UnwrapedItemType>(*v));
+      if (!res) {
+        return res;
+      }
+      acc = std::move(*res);
+    }
+    return Res(std::move(acc));
+  }
+
+  /**
+   * Summary:
+   *    Consumes the iterator together with `other`, maps each pair of items
+   *    at the same position with `map_fn` and reduces the results with `reduce_fn`.
+   *    It stops at the end of the shortest iterator, like `zip`.
+   *    When both iterators are random access (e.g. iterators over `Array`s) the items
+   *    are read by index and reduced into four independent accumulators that are
+   *    combined at the end. That breaks the dependency between consecutive additions,
+   *    so the loop is limited by throughput instead of latency and can be vectorised.
+   *    That's also why `reduce_fn` must be associative and commutative.
+   *
+   * @param other:     The iterator to pair the items with
+   * @param map_fn:    The function that takes an item of each iterator
+   * @param reduce_fn: The function that combines two mapped values
+   * @return:          The reduced value, or nothing if any iterator is empty
+   *
+   * @example:
+   * ```
+   * Array<float> a = ..., b = ...;
+   *
+   * auto l1 = a.iter().zip_reduce(
+   *    b.iter(),
+   *    [](const float &x, const float &y) { return std::abs(x - y); },
+   *    std::plus<>{});
+   * ```
+   */
+  template<typename OtherIterator, typename MapF, typename ReduceF>
+  auto zip_reduce(OtherIterator other, MapF map_fn, ReduceF reduce_fn) {
+    using OtherItemType = internal::unwraped_item_type<OtherIterator>;
+    using Acc = std::decay_t<std::invoke_result_t<MapF, UnwrapedItemType, OtherItemType>>;
+
+    auto *iter = static_cast<IteratorType *>(this);
+    if constexpr (internal::is_random_access_v<IteratorType> && internal::is_random_access_v<OtherIterator>) {
+      constexpr size_t lanes = 4U;
+      const size_t n = iter->len() < other.len() ? iter->len() : other.len();
+      auto mapped = [&](size_t i) -> Acc {
+        return map_fn(static_cast<UnwrapedItemType>((*iter)[i]), static_cast<OtherItemType>(other[i]));
+      };
+
+      std::optional<Acc> res{};
+      size_t i = 0U;
+      if (n >= lanes) {
+        Acc acc[lanes] = {mapped(0U), mapped(1U), mapped(2U), mapped(3U)};
+        for (i = lanes; i + lanes <= n; i += lanes) {
+          for (size_t lane = 0U; lane != lanes; ++lane) {
+            acc[lane] = reduce_fn(acc[lane], mapped(i + lane));
+          }
+        }
+        res = std::make_optional(reduce_fn(reduce_fn(acc[0], acc[1]), reduce_fn(acc[2], acc[3])));
+      }
+      for (; i != n; ++i) {
+        res = std::make_optional(res.has_value() ? reduce_fn(*res, mapped(i)) : mapped(i));
+      }
+
+      iter->advance_read_by(n);
+      return res;
+    } else {
+      std::optional<Acc> res{};
+      auto lhs = iter->next();
+      auto rhs = other.next();
+      for (; lhs.has_value() && rhs.has_value(); lhs = iter->next(), rhs = other.next()) {
+        Acc v = map_fn(static_cast<UnwrapedItemType>(*lhs), static_cast<OtherItemType>(*rhs));
+        res = std::make_optional(res.has_value() ? reduce_fn(*res, v) : v);
+      }
+      return res;
+    }
+  }
+
+  /**
+   * Summary:
+   *    Consumes the iterator together with `other` and returns the
+   *    dot product of their items, i.e. the sum of the products of the
+   *    items at the same position. See `zip_reduce` for how it's computed.
+   *
+   * @param other: The iterator to multiply the items with
+   * @return:      The dot product, which is 0 if any iterator is empty
+   *
+   * @example:
+   * ```
+   * Array<double> a = ..., b = ...;
+   *
+   * double similarity = a.iter().dot(b.iter()) / (norm(a) * norm(b));
+   * ```
+   */
+  template<typename OtherIterator>
+  auto dot(OtherIterator other) {
+    auto res = zip_reduce(other, std::multiplies<>{}, std::plus<>{});
+    using Product = typename decltype(res)::value_type;
+    return res.has_value() ? *res : Product{};
+  }
+
   /**
    * Summary:
    *    Consumes the iterator and joins each item using the separator
@@ -1546,6 +3691,103 @@ struct Iterator {
     return count;
   }
 
+  /**
+   * Summary:
+   *    Advances the iterator by `n` items, discarding them.
+   *    The default implementation calls `next` `n` times. Iterators
+   *    that can skip items cheaper (e.g. random access ones) should
+   *    shadow this method.
+   *
+   * @param n: The number of items to advance by
+   * @return:  The number of items actually advanced. If it's less than `n`
+   *           then the iterator was exhausted
+   */
+  size_t advance_by(size_t n) {
+    auto *iter = static_cast<IteratorType *>(this);
+    for (size_t i = 0U; i != n; ++i) {
+      if (!iter->next().has_value()) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  /**
+   * Summary:
+   *    Same as `advance_by`, but from the back of the iterator, which
+   *    must implement `next_back`. The default implementation calls
+   *    `next_back` `n` times. `Rev` uses it for its `advance_by`.
+   *
+   * @param n: The number of items to advance by
+   * @return:  The number of items actually advanced. If it's less than `n`
+   *           then the iterator was exhausted
+   */
+  size_t advance_back_by(size_t n) {
+    auto *iter = static_cast<IteratorType *>(this);
+    for (size_t i = 0U; i != n; ++i) {
+      if (!iter->next_back().has_value()) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  /**
+   * Summary:
+   *    Advances a random access iterator past `n` items that were already
+   *    read by index, e.g. by `for_each`. Unlike `advance_by`, it doesn't
+   *    evaluate them again, so `Map` doesn't call its function for them.
+   *    The default implementation calls `advance_by`, which is what
+   *    the random access sources do anyway. Adapters forward it.
+   *
+   * @param n: The number of items to advance by
+   * @return:  The number of items actually advanced
+   */
+  size_t advance_read_by(size_t n) {
+    return static_cast<IteratorType *>(this)->advance_by(n);
+  }
+
+  /**
+   * Summary:
+   *    Returns the bounds on the number of remaining items of the iterator.
+   *    The default implementation knows nothing, so it returns `(0, std::nullopt)`.
+   *    Iterators that know their length should shadow this method.
+   *
+   * @return: A pair with the lower bound and, if there is one, the upper bound
+   */
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return {0U, std::nullopt};
+  }
+
+  /**
+   * Summary:
+   *    Consumes the first `n` items of the iterator and returns the next one.
+   *    It is implemented using `advance_by`, so iterators that can skip
+   *    items cheaply get a cheap `nth` as well.
+   *
+   * @param n: The (zero based) index of the item to return
+   * @return:  The `n`th item if the iterator has that many items, std::nullopt otherwise
+   *
+   * @example:
+   * ```
+   * Array<int> ints(3);
+   * ints[0] = 1;
+   * ints[1] = 2;
+   * ints[2] = 3;
+   *
+   * auto v = ints.iter().nth(1);
+   *
+   * // v.value() is 2
+   * ```
+   */
+  std::optional<ItemType> nth(size_t n) {
+    auto *iter = static_cast<IteratorType *>(this);
+    if (iter->advance_by(n) != n) {
+      return std::nullopt;
+    }
+    return iter->next();
+  }
+
   /**
    * Summary:
    *    Consumes the iterator and collects it to a custom
@@ -1589,6 +3831,40 @@ struct Iterator {
     return Collection<ItemType>::from_iterator(*it);
   }
 
+  /**
+   * Summary:
+   *    Consumes an iterator over `Result`s and collects the values, like
+   *    `collect`, unless one of the items is an error. Then it stops reading
+   *    at that item and returns the error instead.
+   *
+   * @tparam Collection: The type of the collection to collect to
+   * @return:            A `Result` with either the collection or the first error
+   *
+   * @example:
+   * ```
+   * auto res = split("1,2,3", ',')
+   *      .try_map(parse_int)
+   *      .try_collect<Array>();
+   *
+   * // res is a Result<Array<int>, std::errc> and *res is: [1, 2, 3]
+   * ```
+   */
+  template<template<typename> typename Collection>
+  auto try_collect() {
+    static_assert(internal::is_result_v<ItemType>, "try_collect needs an iterator over Results");
+
+    using Value = internal::strip_ref_wrapper_t<typename internal::result_traits<ItemType>::Value>;
+    using Error = typename internal::result_traits<ItemType>::Error;
+
+    std::optional<Error> error{};
+    internal::ResultShunt<IteratorType> values(*static_cast<IteratorType *>(this), &error);
+    Collection<Value> res = Collection<Value>::from_iterator(values);
+    if (error.has_value()) {
+      return Result<Collection<Value>, Error>(Err{std::move(*error)});
+    }
+    return Result<Collection<Value>, Error>(std::move(res));
+  }
+
   /**
    * Summary:
    *    Creates a clone of the current iterator state.
@@ -1684,4 +3960,81 @@ struct Iterator {
   std::optional<ItemType> yielded{};
 };
 
+/**
+ * Summary:
+ *      An iterator that yields every way to choose `k` out of `n` items
+ *      as a bitmask, where bit `i` is set if item `i` is chosen. The masks
+ *      are yielded in increasing order and each one is computed from the
+ *      previous one in a few instructions (Gosper's hack), so there is no
+ *      state besides the current mask. That's the fastest way to enumerate the
+ *      combinations of at most 64 items.
+ *      To get an iterator of this type, call `combination_masks`.
+ *
+ * @example:
+ * ```
+ * Array<int> ints(4);
+ *
+ * // Yields: 0b0011, 0b0101, 0b0110, 0b1001, 0b1010, 0b1100
+ * auto masks = combination_masks(ints.len(), 2);
+ *
+ * for (uint64_t mask : masks) {
+ *      // Visit the chosen items
+ *      for (uint64_t bits = mask; bits != 0U; bits &= bits - 1U) {
+ *          use(ints[__builtin_ctzll(bits)]);
+ *      }
+ * }
+ * ```
+ */
+struct CombinationMasks : public Iterator<uint64_t, CombinationMasks> {
+  using ItemType = uint64_t;
+
+  static constexpr size_t MAX_ITEMS = 64U;
+
+  /**
+   * Summary:
+   *    A mask has a bit per item, so there can be at most `MAX_ITEMS` items.
+   *    With more than that, the iterator asserts, or yields nothing if asserts are off.
+   */
+  CombinationMasks(size_t n, size_t k)
+      : mask{k == 0U ? 0U : (k >= MAX_ITEMS ? ~uint64_t{0} : (uint64_t{1} << k) - 1U)},
+        remaining{n <= MAX_ITEMS ? internal::binomial(n, k) : 0U} {
+    assert(n <= MAX_ITEMS);
+  }
+
+  std::optional<ItemType> next() {
+    if (this->remaining == 0U) {
+      return std::nullopt;
+    }
+
+    const uint64_t res = this->mask;
+    if (--this->remaining != 0U) {
+      const uint64_t lowest = this->mask & (~this->mask + 1U);
+      const uint64_t ripple = this->mask + lowest;
+      this->mask = (((ripple ^ this->mask) >> 2U) / lowest) | ripple;
+    }
+    return std::make_optional(res);
+  }
+
+  [[nodiscard]] size_t len() const noexcept { return this->remaining; }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(len(), std::make_optional(len()));
+  }
+
+  uint64_t mask;
+  size_t remaining;
+};
+
+/**
+ * Summary:
+ *      Creates an iterator over the bitmasks of every way to choose `k` out of `n` items
+ *
+ * @param n: The number of items. It must be at most 64
+ * @param k: The number of items to choose
+ * @return:  A `CombinationMasks` iterator
+ */
+inline CombinationMasks combination_masks(size_t n, size_t k) {
+  return CombinationMasks(n, k);
+}
+
 #endif //ITERATOR__ITERATOR_H
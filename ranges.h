@@ -0,0 +1,154 @@
+#ifndef ITERATOR__RANGES_H
+#define ITERATOR__RANGES_H
+
+#if __cplusplus < 202002L
+#error "ranges.h requires C++20"
+#endif
+
+#include <compare>
+#include <iterator>
+#include <ranges>
+#include "iterator.h"
+
+/**
+ * Summary:
+ *      A `std::ranges::view` over an iterator pipeline, so that pipelines can be
+ *      handed to standard algorithms and to `std::ranges` without a `collect` step.
+ *      If the pipeline is random access (see `internal::is_random_access_v`), the view
+ *      is a sized random access range and items are read by index, which also makes it
+ *      usable with the parallel algorithms. Otherwise it is a single pass input range
+ *      that drives the pipeline through `next`.
+ *      Items that are references are exposed as references, so algorithms like
+ *      `std::sort` can write through a random access view over an `Array`.
+ *      To get a view of this type, call `as_view`.
+ *
+ * @tparam IteratorType: The type of the pipeline
+ *
+ * @example:
+ * ```
+ * Array<int> ints(3);
+ * ints[0] = 3;
+ * ints[1] = 1;
+ * ints[2] = 2;
+ *
+ * auto view = as_view(ints.iter());
+ * std::sort(view.begin(), view.end());
+ *
+ * // ints is: [1, 2, 3]
+ *
+ * auto squares = as_view(ints.iter().map([](const int &v) { return v * v; }));
+ * int sum = std::reduce(std::execution::par, squares.begin(), squares.end());
+ *
+ * // sum is 14
+ * ```
+ */
+template<typename IteratorType>
+struct PipelineView : public std::ranges::view_interface<PipelineView<IteratorType>> {
+  using ItemType = internal::item_type<IteratorType>;
+  using ValueType = internal::strip_ref_wrapper_t<ItemType>;
+  using Reference = std::conditional_t<internal::is_ref_wrapper_v<ItemType>,
+                                       internal::unwrap_ref_wrapper_t<ItemType>, ItemType>;
+
+  static constexpr bool is_random_access = internal::is_random_access_v<IteratorType>;
+
+  struct RandomAccessCursor {
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::conditional_t<std::is_reference_v<Reference>,
+                                                 std::random_access_iterator_tag, std::input_iterator_tag>;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+
+    RandomAccessCursor() = default;
+    RandomAccessCursor(const IteratorType *pipeline, difference_type index) : pipeline{pipeline}, index{index} {}
+
+    reference operator*() const { return (*pipeline)[static_cast<size_t>(index)]; }
+    reference operator[](difference_type n) const { return (*pipeline)[static_cast<size_t>(index + n)]; }
+
+    RandomAccessCursor &operator++() { ++index; return *this; }
+    RandomAccessCursor operator++(int) { auto res = *this; ++index; return res; }
+    RandomAccessCursor &operator--() { --index; return *this; }
+    RandomAccessCursor operator--(int) { auto res = *this; --index; return res; }
+    RandomAccessCursor &operator+=(difference_type n) { index += n; return *this; }
+    RandomAccessCursor &operator-=(difference_type n) { index -= n; return *this; }
+
+    friend RandomAccessCursor operator+(RandomAccessCursor it, difference_type n) { return it += n; }
+    friend RandomAccessCursor operator+(difference_type n, RandomAccessCursor it) { return it += n; }
+    friend RandomAccessCursor operator-(RandomAccessCursor it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const RandomAccessCursor &lhs, const RandomAccessCursor &rhs) {
+      return lhs.index - rhs.index;
+    }
+
+    friend bool operator==(const RandomAccessCursor &lhs, const RandomAccessCursor &rhs) {
+      return lhs.index == rhs.index;
+    }
+    friend auto operator<=>(const RandomAccessCursor &lhs, const RandomAccessCursor &rhs) {
+      return lhs.index <=> rhs.index;
+    }
+
+    const IteratorType *pipeline{nullptr};
+    difference_type index{0};
+  };
+
+  struct InputCursor {
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<internal::is_ref_wrapper_v<ItemType>, Reference, ItemType &>;
+
+    InputCursor() = default;
+    explicit InputCursor(PipelineView *view) : view{view} {}
+
+    reference operator*() const { return *view->current; }
+
+    InputCursor &operator++() {
+      view->current = view->pipeline.next();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const InputCursor &it, std::default_sentinel_t) { return !it.view->current.has_value(); }
+
+    PipelineView *view{nullptr};
+  };
+
+  explicit PipelineView(IteratorType pipeline) : pipeline{pipeline}, current{} {}
+
+  auto begin() const requires is_random_access {
+    return RandomAccessCursor(&pipeline, 0);
+  }
+
+  auto end() const requires is_random_access {
+    return RandomAccessCursor(&pipeline, static_cast<std::ptrdiff_t>(pipeline.len()));
+  }
+
+  [[nodiscard]] size_t size() const requires is_random_access {
+    return pipeline.len();
+  }
+
+  auto begin() requires (!is_random_access) {
+    current = pipeline.next();
+    return InputCursor(this);
+  }
+
+  std::default_sentinel_t end() requires (!is_random_access) {
+    return std::default_sentinel;
+  }
+
+  IteratorType pipeline;
+  std::optional<ItemType> current;
+};
+
+/**
+ * Summary:
+ *      Wraps an iterator pipeline into a `std::ranges::view`
+ *
+ * @param pipeline: The pipeline to wrap
+ * @return:         A `PipelineView`
+ */
+template<typename IteratorType>
+PipelineView<IteratorType> as_view(IteratorType pipeline) {
+  return PipelineView<IteratorType>(pipeline);
+}
+
+#endif //ITERATOR__RANGES_H
@@ -0,0 +1,121 @@
+#include "../unit_test.h"
+#include "../data_structures/array_expr.h"
+
+UNIT_TEST(array_expr_arithmetic_works) {
+  Array<double> a{100};
+  Array<double> b{100};
+  Array<double> c{100};
+  for (size_t i = 0U; i != a.len(); ++i) {
+    a[i] = (double) i + 1;
+    b[i] = (double) i + 2;
+    c[i] = (double) i + 3;
+  }
+
+  Array<double> res = a * b + c;
+  ASSERT(res.len() == 100);
+  for (size_t i = 0U; i != res.len(); ++i) {
+    ASSERT(res[i] == a[i] * b[i] + c[i]);
+  }
+
+  Array<double> scaled = (a - 1.0) / 2.0;
+  ASSERT(scaled[0] == 0 && scaled[10] == 5);
+
+  Array<double> flipped = 10.0 - a;
+  ASSERT(flipped[0] == 9 && flipped[9] == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_expr_assignment_works) {
+  Array<double> a{8};
+  Array<double> b{8};
+  for (size_t i = 0U; i != a.len(); ++i) {
+    a[i] = (double) i;
+    b[i] = (double) i + 1;
+  }
+
+  a = a * b;
+  ASSERT(a.len() == 8);
+  ASSERT(a[0] == 0 && a[1] == 2 && a[7] == 56);
+
+  Array<double> dst{};
+  dst = b + b + b;
+  ASSERT(dst.len() == 8);
+  ASSERT(dst[3] == 12);
+
+  Array<int> truncated = b * 1.5;
+  ASSERT(truncated[1] == 3);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_expr_lengths_work) {
+  Array<double> a{5};
+  Array<double> b{3};
+
+  auto expr = a + b;
+  ASSERT(expr.len() == 3);
+  ASSERT(expr.eval().len() == 3);
+
+  Array<double> empty{};
+  ASSERT((empty * 2.0).eval().len() == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_expr_assignment_to_operand_resizes) {
+  Array<double> a{5};
+  for (size_t i = 0U; i != a.len(); ++i) {
+    a[i] = (double) i + 1;
+  }
+  Array<double> b{3};
+  b[0] = 10;
+  b[1] = 11;
+  b[2] = 12;
+
+  // The expression reads from `a` while `a` gets a new length
+  a = a + b;
+  ASSERT(a.len() == 3);
+  ASSERT(a[0] == 11 && a[1] == 13 && a[2] == 15);
+
+  Array<double> c{2};
+  c[0] = 0;
+  c[1] = 1;
+  b = b * c - b;
+  ASSERT(b.len() == 2);
+  ASSERT(b[0] == -10 && b[1] == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_expr_iter_works) {
+  Array<double> a{4};
+  a[0] = 1;
+  a[1] = 2;
+  a[2] = 3;
+  a[3] = 4;
+
+  ASSERT((a * a).iter().sum() == 30);
+  ASSERT(*(a * a).iter().rev().next() == 16);
+
+  auto squares = (a * a).iter().collect<Array>();
+  ASSERT(squares.len() == 4 && squares[3] == 16);
+
+  auto clamped = zip_with(a, 2.5, [](double x, double hi) { return x < hi ? x : hi; }).eval();
+  ASSERT(clamped[0] == 1 && clamped[1] == 2 && clamped[2] == 2.5 && clamped[3] == 2.5);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_array_expr_arithmetic_works,
+    test_array_expr_assignment_works,
+    test_array_expr_lengths_work,
+    test_array_expr_assignment_to_operand_resizes,
+    test_array_expr_iter_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
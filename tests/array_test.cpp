@@ -1,3 +1,4 @@
+#include <string>
 #include "../unit_test.h"
 #include "../data_structures/array.h"
 
@@ -105,6 +106,297 @@ UNIT_TEST(array_reserve_works) {
   TEST_PASSED();
 }
 
+UNIT_TEST(gather_works) {
+  Array<int> table{100};
+  for (size_t i = 0U; i != table.len(); ++i) {
+    table[i] = i * 10;
+  }
+
+  Array<size_t> ids{5};
+  ids[0] = 99;
+  ids[1] = 3;
+  ids[2] = 50;
+  ids[3] = 3;
+  ids[4] = 0;
+
+  auto iter = gather(table, ids.iter(), 2);
+  ASSERT(iter.len() == 5);
+  ASSERT(*iter.next() == 990);
+  ASSERT(*iter.next() == 30);
+  ASSERT(iter.sum() == 530);
+
+  auto filtered = gather(table, ids.iter().filter([](const size_t &id) { return id != 3; }), 4);
+  ASSERT(filtered.sum() == 1490);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_bounds_work) {
+  // [0, 2, 2, 2, 8, 10, ..., 98]
+  Array<int> ints{50};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i * 2;
+  }
+  ints[2] = 2;
+  ints[3] = 2;
+
+  ASSERT(ints.lower_bound(2).cursor == 1);
+  ASSERT(ints.upper_bound(2).cursor == 4);
+  ASSERT(*ints.lower_bound(2).next() == 2);
+  ASSERT(*ints.lower_bound(5).next() == 8);
+  ASSERT(ints.lower_bound(-1).cursor == 0);
+  ASSERT(!ints.lower_bound(99).next().has_value());
+  ASSERT(ints.upper_bound(98).len() == 0);
+  ASSERT(ints.lower_bound(97).len() == 1);
+
+  for (int v = -1; v != 101; ++v) {
+    size_t expected = 0U;
+    while (expected != ints.len() && ints[expected] < v) {
+      ++expected;
+    }
+    ASSERT(ints.lower_bound(v).cursor == expected);
+  }
+
+  Array<int> empty{};
+  ASSERT(!empty.lower_bound(1).next().has_value());
+  ASSERT(!empty.binary_search(1).next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_equal_range_works) {
+  Array<int> ints{6};
+  ints[0] = 1;
+  ints[1] = 3;
+  ints[2] = 3;
+  ints[3] = 3;
+  ints[4] = 5;
+  ints[5] = 7;
+
+  ASSERT(ints.equal_range(3).count() == 3);
+  ASSERT(ints.equal_range(3).sum() == 9);
+  ASSERT(ints.equal_range(4).count() == 0);
+  ASSERT(ints.equal_range(7).count() == 1);
+
+  ASSERT(*ints.binary_search(5).next() == 5);
+  ASSERT(ints.binary_search(5).len() == 2);
+  ASSERT(!ints.binary_search(4).next().has_value());
+  ASSERT(!ints.binary_search(8).next().has_value());
+  ASSERT(!ints.binary_search(0).next().has_value());
+
+  // Sorted in descending order
+  Array<int> desc{4};
+  desc[0] = 9;
+  desc[1] = 5;
+  desc[2] = 5;
+  desc[3] = 1;
+  ASSERT(desc.lower_bound(5, std::greater<>{}).cursor == 1);
+  ASSERT(desc.equal_range(5, std::greater<>{}).count() == 2);
+  ASSERT(*desc.binary_search(1, std::greater<>{}).next() == 1);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_iter_mut_works) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i - 2;
+  }
+
+  ints.iter_mut()
+      .filter([](const int &v) { return v < 0; })
+      .for_each([](int &v) { v = 0; });
+  ASSERT(ints[0] == 0 && ints[1] == 0 && ints[2] == 0 && ints[3] == 1 && ints[4] == 2);
+
+  ints.for_each_mut([](int &v) { v += 1; });
+  ASSERT(ints.iter().sum() == 8);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_transform_in_place_works) {
+  Array<float> floats{100};
+  for (size_t i = 0U; i != floats.len(); ++i) {
+    floats[i] = (float) i;
+  }
+
+  floats.transform_in_place([](const float &v) { return v * 2.0f + 1.0f; });
+  for (size_t i = 0U; i != floats.len(); ++i) {
+    ASSERT(floats[i] == (float) i * 2.0f + 1.0f);
+  }
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_retain_works) {
+  Array<int> ints{10};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  ints.retain([](const int &v) { return v % 3 == 0; });
+  ASSERT(ints.len() == 4);
+  ASSERT(ints[0] == 0 && ints[1] == 3 && ints[2] == 6 && ints[3] == 9);
+
+  ints.retain([](const int &v) { return v > 100; });
+  ASSERT(ints.len() == 0);
+  ASSERT(!ints.iter().next().has_value());
+
+  Array<std::string> strings{3};
+  strings[0] = "keep";
+  strings[1] = "drop";
+  strings[2] = "keep too";
+  strings.retain([](const std::string &s) { return s.rfind("keep", 0) == 0; });
+  ASSERT(strings.len() == 2 && strings[1] == "keep too");
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_dedup_works) {
+  Array<int> ints{7};
+  ints[0] = 1;
+  ints[1] = 1;
+  ints[2] = 2;
+  ints[3] = 1;
+  ints[4] = 1;
+  ints[5] = 3;
+  ints[6] = 3;
+
+  ints.dedup();
+  ASSERT(ints.len() == 4);
+  ASSERT(ints[0] == 1 && ints[1] == 2 && ints[2] == 1 && ints[3] == 3);
+
+  Array<int> empty{};
+  empty.dedup();
+  ASSERT(empty.len() == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_fill_works) {
+  Array<int> ints{10};
+  ints.fill(7);
+  ASSERT(ints.iter().all([](const int &v) { return v == 7; }));
+
+  Array<char> chars{4};
+  chars.fill('x');
+  ASSERT(chars[0] == 'x' && chars[3] == 'x');
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_into_iter_works) {
+  Array<std::string> words{4};
+  words[0] = "a rather long string that is not inlined";
+  words[1] = "short";
+  words[2] = "another rather long string that is not inlined";
+  words[3] = "tiny";
+  const char *first_data = words[0].data();
+
+  auto iter = std::move(words).into_iter();
+  ASSERT(words.len() == 0);
+  ASSERT(iter.len() == 4);
+
+  auto long_words = iter
+      .filter([](const std::string &w) { return w.size() > 10; })
+      .collect<Array>();
+  ASSERT(long_words.len() == 2);
+  ASSERT(long_words[1] == "another rather long string that is not inlined");
+
+  Array<std::string> more{2};
+  more[0] = "a rather long string that is not inlined";
+  more[1] = "b rather long string that is not inlined";
+  first_data = more[0].data();
+  auto moved = std::move(more).into_iter().collect<Array>();
+  ASSERT(moved.len() == 2);
+  ASSERT(moved[0].data() == first_data);
+
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+  auto back = std::move(ints).into_iter();
+  ASSERT(*back.next_back() == 4);
+  ASSERT(*back.next() == 0);
+  ASSERT(back.clone().sum() == 6);
+  ASSERT(back.count() == 3);
+  ASSERT(!back.next().has_value());
+  ASSERT(!back.buffer);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_drain_works) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i + 1;
+  }
+
+  ASSERT(ints.drain(1, 3).sum() == 5);
+  ASSERT(ints.len() == 3);
+  ASSERT(ints[0] == 1 && ints[1] == 4 && ints[2] == 5);
+
+  ASSERT(ints.drain(2, 10).count() == 1);
+  ASSERT(ints.len() == 2);
+  ASSERT(ints.drain(1, 1).count() == 0);
+  ASSERT(ints.drain(0, 2).count() == 2);
+  ASSERT(ints.len() == 0);
+
+  Array<std::string> strings{3};
+  strings[0] = "x";
+  strings[1] = "y";
+  strings[2] = "z";
+  auto drained = strings.drain(0, 2).collect<Array>();
+  ASSERT(drained.len() == 2 && drained[0] == "x" && drained[1] == "y");
+  ASSERT(strings.len() == 1 && strings[0] == "z");
+
+  TEST_PASSED();
+}
+
+/**
+ * Summary:
+ *      Yields `0..count` but reports `hint` as its exact length
+ */
+struct WrongHint : public Iterator<int, WrongHint> {
+  using ItemType = int;
+
+  WrongHint(int count, size_t hint) : current{0}, count{count}, hint{hint} {}
+
+  std::optional<ItemType> next() {
+    if (this->current != this->count) {
+      return std::make_optional(this->current++);
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return std::make_pair(this->hint, std::make_optional(this->hint));
+  }
+
+  int current;
+  int count;
+  size_t hint;
+};
+
+UNIT_TEST(array_collect_survives_a_wrong_hint) {
+  auto more = WrongHint(5, 2).collect<Array>();
+  ASSERT(more.len() == 5);
+  for (size_t i = 0U; i != more.len(); ++i) {
+    ASSERT(more[i] == (int) i);
+  }
+
+  auto fewer = WrongHint(3, 8).collect<Array>();
+  ASSERT(fewer.len() == 3);
+  ASSERT(fewer[0] == 0 && fewer[2] == 2);
+
+  auto exact = WrongHint(4, 4).collect<Array>();
+  ASSERT(exact.len() == 4 && exact[3] == 3);
+
+  ASSERT(WrongHint(0, 1).collect<Array>().len() == 0);
+
+  TEST_PASSED();
+}
+
 TestFn tests[] = {
     test_array_default_ctor_works,
     test_array_size_ctor_works,
@@ -112,7 +404,18 @@ TestFn tests[] = {
     test_array_move_ctor_works,
     test_array_copy_assignment_works,
     test_array_move_assignment_works,
-    test_array_reserve_works
+    test_array_reserve_works,
+    test_gather_works,
+    test_array_bounds_work,
+    test_array_equal_range_works,
+    test_array_iter_mut_works,
+    test_array_transform_in_place_works,
+    test_array_retain_works,
+    test_array_dedup_works,
+    test_array_fill_works,
+    test_array_into_iter_works,
+    test_array_drain_works,
+    test_array_collect_survives_a_wrong_hint
 };
 
 int main() {
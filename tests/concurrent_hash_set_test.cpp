@@ -0,0 +1,130 @@
+#include <string>
+#include <thread>
+#include "../unit_test.h"
+#include "../data_structures/concurrent_hash_set.h"
+
+UNIT_TEST(concurrent_hash_set_insert_works) {
+  ConcurrentHashSet<std::string> set{};
+  ASSERT(set.insert("foo"));
+  ASSERT(set.insert("bar"));
+  ASSERT(!set.insert("foo"));
+  ASSERT(set.len() == 2);
+  ASSERT(set.contains("bar"));
+  ASSERT(!set.contains("baz"));
+
+  // Enough items to make the shards grow
+  for (int i = 0; i != 10000; ++i) {
+    set.insert(std::to_string(i % 1000));
+  }
+  ASSERT(set.len() == 1002);
+  ASSERT(set.iter().count() == 1002);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(concurrent_hash_set_insert_at_keeps_smallest_index) {
+  ConcurrentHashSet<int> set{1};
+  ASSERT(set.num_shards() == 1);
+  ASSERT(set.insert_at(5, 10));
+  ASSERT(!set.insert_at(5, 12));
+  ASSERT(set.insert_at(5, 3));
+  ASSERT(*set.first_index(5) == 3);
+  ASSERT(!set.first_index(6).has_value());
+
+  ASSERT(set.insert(6));
+  ASSERT(!set.first_index(6).has_value());
+  ASSERT(set.insert_at(6, 0));
+  ASSERT(*set.first_index(6) == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(concurrent_hash_set_parallel_insert_works) {
+  ConcurrentHashSet<int> set{};
+  constexpr int num_threads = 4;
+  size_t inserted[num_threads] = {};
+
+  std::vector<std::thread> threads{};
+  for (int t = 0; t != num_threads; ++t) {
+    threads.emplace_back([&set, &inserted, t]() {
+      // Every thread inserts all the items, each one is new for exactly one thread
+      for (int i = 0; i != 20000; ++i) {
+        if (set.insert((i * 31 + t) % 20000)) {
+          ++inserted[t];
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT(set.len() == 20000);
+  ASSERT(inserted[0] + inserted[1] + inserted[2] + inserted[3] == 20000);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(par_unique_keeps_first_occurrences) {
+  Array<int> ints{100000};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    // Goes backwards through 0..997, so the order of first occurrences isn't sorted
+    ints[i] = 996 - (int) ((i * 7U) % 997U);
+  }
+
+  auto expected = ints.iter().unique().collect<Array>();
+
+  for (size_t threads : {1U, 2U, 4U, 8U}) {
+    auto unique = par_unique(ints.iter(), UniqueOrder::FirstOccurrence, threads);
+    ASSERT(unique.len() == expected.len());
+    for (size_t i = 0U; i != unique.len(); ++i) {
+      ASSERT(unique[i] == expected[i]);
+    }
+  }
+
+  Array<int> small{5};
+  small[0] = 2;
+  small[1] = 1;
+  small[2] = 2;
+  small[3] = 0;
+  small[4] = 1;
+
+  auto unique = par_unique(small.iter());
+  ASSERT(unique.len() == 3);
+  ASSERT(unique[0] == 2 && unique[1] == 1 && unique[2] == 0);
+
+  ASSERT(par_unique(Array<int>{}.iter()).len() == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(par_unique_unordered_works) {
+  Array<int> ints{100000};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) ((i * 7U) % 1000U);
+  }
+
+  auto unique = par_unique(ints.iter().map([](const int &v) { return v / 2; }), UniqueOrder::Unordered, 4U);
+  ASSERT(unique.len() == 500);
+
+  ConcurrentHashSet<int> seen{};
+  for (size_t i = 0U; i != unique.len(); ++i) {
+    ASSERT(seen.insert(unique[i]));
+    ASSERT(unique[i] >= 0 && unique[i] < 500);
+  }
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_concurrent_hash_set_insert_works,
+    test_concurrent_hash_set_insert_at_keeps_smallest_index,
+    test_concurrent_hash_set_parallel_insert_works,
+    test_par_unique_keeps_first_occurrences,
+    test_par_unique_unordered_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -0,0 +1,160 @@
+#include "../unit_test.h"
+#include "../data_structures/dict_array.h"
+
+UNIT_TEST(dict_array_default_ctor_works) {
+  DictArray dict{};
+  ASSERT(dict.len() == 0);
+  ASSERT(dict.dictionary_len() == 0);
+  ASSERT(!dict.iter().next().has_value());
+  TEST_PASSED();
+}
+
+UNIT_TEST(dict_array_iteration_works) {
+  Array<std::string> countries{6};
+  countries[0] = "GR";
+  countries[1] = "US";
+  countries[2] = "GR";
+  countries[3] = "DE";
+  countries[4] = "US";
+  countries[5] = "GR";
+
+  DictArray dict(countries);
+
+  ASSERT(dict.len() == 6);
+  ASSERT(dict.dictionary_len() == 3);
+
+  size_t i = 0U;
+  for (std::string_view s : dict.iter()) {
+    ASSERT(s == countries[i]);
+    ASSERT(dict[i] == countries[i]);
+    ++i;
+  }
+  ASSERT(i == countries.len());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(dict_array_codes_works) {
+  Array<std::string> countries{4};
+  countries[0] = "GR";
+  countries[1] = "US";
+  countries[2] = "DE";
+  countries[3] = "US";
+
+  DictArray dict(countries);
+
+  auto codes = dict.codes();
+  ASSERT(*codes.next() == 0);
+  ASSERT(*codes.next() == 1);
+  ASSERT(*codes.next() == 2);
+  ASSERT(*codes.next() == 1);
+  ASSERT(!codes.next().has_value());
+
+  ASSERT(*dict.code_of("GR") == 0);
+  ASSERT(*dict.code_of("US") == 1);
+  ASSERT(*dict.code_of("DE") == 2);
+  ASSERT(!dict.code_of("FR").has_value());
+  ASSERT(!dict.code_of("").has_value());
+  ASSERT(!DictArray{}.code_of("GR").has_value());
+  ASSERT(dict.decode(1) == "US");
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(dict_array_filter_works) {
+  Array<std::string> countries{5};
+  countries[0] = "GR";
+  countries[1] = "US";
+  countries[2] = "GR";
+  countries[3] = "DE";
+  countries[4] = "US";
+
+  DictArray dict(countries);
+
+  size_t calls = 0U;
+  auto iter = dict.filter([&calls](std::string_view s) {
+    ++calls;
+    return s != "GR";
+  });
+
+  ASSERT(calls == 3);
+  ASSERT(*iter.next() == "US");
+  ASSERT(*iter.next() == "DE");
+  ASSERT(*iter.next() == "US");
+  ASSERT(!iter.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(dict_array_unique_and_counts_work) {
+  Array<std::string> countries{6};
+  countries[0] = "GR";
+  countries[1] = "US";
+  countries[2] = "GR";
+  countries[3] = "DE";
+  countries[4] = "US";
+  countries[5] = "GR";
+
+  DictArray dict(countries);
+
+  auto unique = dict.unique();
+  ASSERT(*unique.next() == "GR");
+  ASSERT(*unique.next() == "US");
+  ASSERT(*unique.next() == "DE");
+  ASSERT(!unique.next().has_value());
+
+  auto counts = dict.counts();
+  ASSERT(counts.len() == 3);
+  ASSERT(counts[0] == 3);
+  ASSERT(counts[1] == 2);
+  ASSERT(counts[2] == 1);
+
+  TEST_PASSED();
+}
+
+template<typename T, typename = void>
+struct can_iter : std::false_type {};
+
+template<typename T>
+struct can_iter<T, std::void_t<decltype(std::declval<T>().iter())>> : std::true_type {};
+
+template<typename T, typename = void>
+struct can_unique : std::false_type {};
+
+template<typename T>
+struct can_unique<T, std::void_t<decltype(std::declval<T>().unique().next())>> : std::true_type {};
+
+UNIT_TEST(dict_array_iterators_need_an_lvalue) {
+  // The iterators point into the array, so taking one from a temporary would dangle
+  static_assert(can_iter<const DictArray &>::value);
+  static_assert(!can_iter<DictArray>::value);
+  static_assert(can_unique<const DictArray &>::value);
+  static_assert(!can_unique<DictArray>::value);
+
+  // An iterator taken from a named array can outlive the array it was built from
+  Array<std::string> countries{3};
+  countries[0] = "GR";
+  countries[1] = "US";
+  countries[2] = "GR";
+
+  DictArray dict(countries);
+  auto greek = dict.filter([](std::string_view s) { return s == "GR"; });
+  countries = Array<std::string>{};
+  ASSERT(greek.count() == 2);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_dict_array_default_ctor_works,
+    test_dict_array_iteration_works,
+    test_dict_array_codes_works,
+    test_dict_array_filter_works,
+    test_dict_array_unique_and_counts_work,
+    test_dict_array_iterators_need_an_lvalue
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
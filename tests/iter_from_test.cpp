@@ -0,0 +1,171 @@
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include "../unit_test.h"
+#include "../data_structures/array.h"
+#include "../iter_from.h"
+
+UNIT_TEST(iter_from_vector_works) {
+  std::vector<int> ints{1, 2, 3, 4};
+
+  auto iter = iter_from(ints);
+  ASSERT(iter.len() == 4);
+  ASSERT(iter[2] == 3);
+  ASSERT(iter.sum() == 10);
+
+  iter_from(ints).for_each([](int &v) { v *= 2; });
+  ASSERT(ints[3] == 8);
+
+  const std::vector<int> &const_ints = ints;
+  ASSERT(iter_from(const_ints).skip(1).sum() == 18);
+  ASSERT(*iter_from(const_ints).nth(3) == 8);
+  ASSERT(iter_from(const_ints).count() == 4);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(iter_from_pointer_works) {
+  int ints[] = {5, 6, 7};
+
+  auto iter = iter_from(ints, 3);
+  ASSERT(*iter.next_back() == 7);
+  ASSERT(*iter.next() == 5);
+  ASSERT(*iter.next() == 6);
+  ASSERT(!iter.next().has_value());
+  ASSERT(!iter.next_back().has_value());
+
+  auto res = iter_from(ints + 1, ints + 3)
+      .rev()
+      .map([](const int &v) { return v; })
+      .collect<Array>();
+  ASSERT(res.len() == 2);
+  ASSERT(res[0] == 7);
+  ASSERT(res[1] == 6);
+
+  auto[lower, upper] = iter_from(ints).size_hint();
+  ASSERT(lower == 3 && *upper == 3);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(iter_from_node_containers_works) {
+  std::list<int> list{3, 1, 2};
+  ASSERT(iter_from(list).sum() == 6);
+  ASSERT(*iter_from(list).rev().next() == 2);
+  ASSERT(*iter_from(list).nth(1) == 1);
+
+  std::set<int> set{3, 1, 2};
+  auto res = iter_from(set)
+      .map([](const int &v) { return v * 10; })
+      .collect<Array>();
+  ASSERT(res.len() == 3);
+  ASSERT(res[0] == 10);
+  ASSERT(res[2] == 30);
+
+  std::map<int, std::string> map{{1, "a"}, {2, "b"}};
+  auto value = iter_from(map)
+      .find([](const std::pair<const int, std::string> &kv) { return kv.first == 2; });
+  ASSERT(value.has_value() && value->get().second == "b");
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(iter_from_std_iterators_works) {
+  std::vector<int> ints{1, 2, 3, 4, 5};
+
+  auto iter = iter_from(ints.begin() + 1, ints.end());
+  ASSERT(iter.advance_by(2) == 2);
+  ASSERT(*iter.next() == 4);
+  ASSERT(iter.advance_by(10) == 1);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(array_iterator_double_ended_works) {
+  Array<int> ints{4};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  auto iter = ints.iter();
+  ASSERT(*iter.next_back() == 3);
+  ASSERT(iter.len() == 3);
+  ASSERT(iter[1] == 1);
+  ASSERT(*iter.next() == 0);
+  ASSERT(iter.count() == 2);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(strided_works) {
+  float points[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  ASSERT(strided(points + 1, 3, 3).sum() == 15);
+
+  auto iter = strided(points, 3, 3);
+  ASSERT(iter.len() == 3);
+  ASSERT(iter[2] == 7);
+  ASSERT(*iter.next_back() == 7);
+  ASSERT(*iter.next() == 1);
+  ASSERT(*iter.next() == 4);
+  ASSERT(!iter.next().has_value());
+
+  strided(points + 2, 3, 3).for_each([](float &v) { v = 0; });
+  ASSERT(points[2] == 0 && points[5] == 0 && points[8] == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(step_by_random_access_works) {
+  std::vector<int> ints(100);
+  for (size_t i = 0U; i != ints.size(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  auto iter = iter_from(ints).step_by(7);
+  ASSERT(iter.len() == 15);
+  ASSERT(iter[3] == 21);
+  ASSERT(*iter.nth(10) == 70);
+  ASSERT(*iter.next() == 77);
+  ASSERT(iter.len() == 3);
+  ASSERT(iter.count() == 3);
+
+  ASSERT(*iter_from(ints).map([](const int &v) { return v * 2; }).step_by(10).nth(9) == 180);
+  ASSERT(iter_from(ints).step_by(33).sum() == 198);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(slice_position_of_works) {
+  std::string line = "key=value=more";
+
+  auto iter = iter_from(line);
+  ASSERT(*iter.position_of('=') == 3);
+  ASSERT(*iter.position_of('=') == 5);
+  ASSERT(!iter.position_of('=').has_value());
+
+  ASSERT(*iter_from(line).rposition([](const char &c) { return c == '='; }) == 9);
+
+  const std::vector<double> doubles{0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5};
+  ASSERT(*iter_from(doubles).position_of(8.5) == 8);
+  ASSERT(!iter_from(doubles).position_of(1.0).has_value());
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_iter_from_vector_works,
+    test_iter_from_pointer_works,
+    test_iter_from_node_containers_works,
+    test_iter_from_std_iterators_works,
+    test_array_iterator_double_ended_works,
+    test_strided_works,
+    test_step_by_random_access_works,
+    test_slice_position_of_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -588,6 +588,648 @@ UNIT_TEST(collect_works) {
   TEST_PASSED();
 }
 
+UNIT_TEST(rle_works) {
+  Array<std::string> strings{6};
+  strings[0] = "a";
+  strings[1] = "a";
+  strings[2] = "a";
+  strings[3] = "b";
+  strings[4] = "a";
+  strings[5] = "a";
+
+  auto iter = strings.iter().rle();
+
+  auto run = iter.next();
+  ASSERT(run.has_value() && run->first == "a" && run->second == 3);
+  run = iter.next();
+  ASSERT(run.has_value() && run->first == "b" && run->second == 1);
+  run = iter.next();
+  ASSERT(run.has_value() && run->first == "a" && run->second == 2);
+  ASSERT(!iter.next().has_value());
+
+  auto runs = strings.iter().rle().collect<Array>();
+  ASSERT(runs.len() == 3);
+  ASSERT(runs[1].first == "b" && runs[1].second == 1);
+  ASSERT(runs[2].first == "a" && runs[2].second == 2);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(nth_works) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i + 1;
+  }
+
+  auto iter = ints.iter();
+  ASSERT(*iter.nth(1) == 2);
+  ASSERT(*iter.nth(1) == 4);
+  ASSERT(!iter.nth(1).has_value());
+
+  ASSERT(*ints.iter().filter([](const int &v) { return v % 2 == 1; }).nth(2) == 5);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(prefetch_works) {
+  Array<int> ints{10};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i;
+  }
+
+  size_t prefetched = 0U;
+  auto addr = [&prefetched, &ints](const int &v) {
+    ++prefetched;
+    return &ints[v];
+  };
+
+  auto odds = ints.iter()
+      .filter([](const int &v) { return v % 2 == 1; })
+      .prefetch(3, addr);
+
+  ASSERT(*odds.next() == 1);
+  ASSERT(prefetched == 4);
+  ASSERT(*odds.next() == 3);
+  ASSERT(odds.count() == 3);
+  ASSERT(prefetched == 5);
+
+  prefetched = 0U;
+  ASSERT(ints.iter().prefetch(0, addr).sum() == 45);
+  ASSERT(prefetched == 10);
+
+  prefetched = 0U;
+  ASSERT(ints.iter().prefetch(4, addr).sum() == 45);
+  ASSERT(prefetched == 6);
+
+  // for_each and collect read random access pipelines by index
+  prefetched = 0U;
+  int sum = 0;
+  ints.iter().prefetch(4, addr).for_each([&sum](const int &v) { sum += v; });
+  ASSERT(sum == 45);
+  ASSERT(prefetched == 6);
+
+  prefetched = 0U;
+  auto collected = ints.iter().prefetch(4, addr).map([](const int &v) { return v; }).collect<Array>();
+  ASSERT(collected.len() == 10);
+  ASSERT(prefetched == 6);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(zip_reduce_works) {
+  Array<int> a{10};
+  Array<int> b{7};
+  for (size_t i = 0U; i != a.len(); ++i) {
+    a[i] = (int) i + 1;
+  }
+  for (size_t i = 0U; i != b.len(); ++i) {
+    b[i] = 2;
+  }
+
+  auto max_diff = a.iter().zip_reduce(
+      b.iter(),
+      [](const int &x, const int &y) { return x - y; },
+      [](const int &x, const int &y) { return x > y ? x : y; });
+  ASSERT(max_diff.has_value() && *max_diff == 5);
+
+  auto filtered = a.iter()
+      .filter([](const int &v) { return v % 2 == 0; })
+      .zip_reduce(a.iter(), std::multiplies<>{}, std::plus<>{});
+  ASSERT(filtered.has_value() && *filtered == 2 * 1 + 4 * 2 + 6 * 3 + 8 * 4 + 10 * 5);
+
+  ASSERT(!a.iter().zip_reduce(Array<int>{}.iter(), std::multiplies<>{}, std::plus<>{}).has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(dot_works) {
+  for (size_t len = 0U; len != 12U; ++len) {
+    Array<double> a{len};
+    Array<double> b{len};
+    double expected = 0.0;
+    for (size_t i = 0U; i != len; ++i) {
+      a[i] = (double) i;
+      b[i] = 0.5 * (double) i;
+      expected += a[i] * b[i];
+    }
+    ASSERT(a.iter().dot(b.iter()) == expected);
+  }
+
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+  ASSERT(ints.iter().dot(ints.iter().rev()) == 0 * 4 + 1 * 3 + 2 * 2 + 3 * 1 + 4 * 0);
+  ASSERT(ints.iter().skip(1).dot(ints.iter().map([](const int &v) { return v * 2; })) == 40);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(cartesian_product_works) {
+  Array<int> ints{3};
+  Array<char> chars{2};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+  chars[0] = 'a';
+  chars[1] = 'b';
+
+  auto product = ints.iter().cartesian_product(chars.iter());
+  ASSERT(product.len() == 6);
+  ASSERT(product.size_hint().second == 6U);
+
+  auto third = product[2];
+  ASSERT(third.first == 1 && third.second == 'a');
+
+  auto first = product.next();
+  ASSERT(first->first == 0 && first->second == 'a');
+  ASSERT(product.len() == 5);
+  auto fourth = product.nth(2);
+  ASSERT(fourth->first == 1 && fourth->second == 'b');
+  ASSERT(product.count() == 2);
+
+  // Not random access
+  auto evens = ints.iter().filter([](const int &v) { return v % 2 == 0; });
+  auto filtered = evens.cartesian_product(chars.iter());
+  ASSERT(filtered.size_hint().first == 0);
+  ASSERT(!filtered.size_hint().second.has_value());
+  auto pair = filtered.nth(3);
+  ASSERT(pair->first == 2 && pair->second == 'b');
+  ASSERT(!filtered.next().has_value());
+
+  ASSERT(ints.iter().cartesian_product(Array<char>{}.iter()).count() == 0);
+  ASSERT(!ints.iter().cartesian_product(Array<char>{}.iter()).next().has_value());
+
+  // The inner side holds a lambda, so it can only be rebuilt, not assigned
+  auto odd_ints = ints.iter().filter([](const int &v) { return v % 2 == 1; });
+  auto upper = chars.iter().map([](const char &c) { return (char) (c - 'a' + 'A'); });
+  auto mixed = evens.cartesian_product(upper);
+  auto first_mixed = mixed.next();
+  ASSERT(first_mixed->first == 0 && first_mixed->second == 'A');
+  auto last_mixed = mixed.nth(2);
+  ASSERT(last_mixed->first == 2 && last_mixed->second == 'B');
+  ASSERT(!mixed.next().has_value());
+  ASSERT(odd_ints.cartesian_product(evens).count() == 2);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(cartesian_product_blocked_works) {
+  // Big enough for the inner side to span several blocks
+  Array<int> outer{3};
+  Array<int> inner{10000};
+  for (size_t i = 0U; i != outer.len(); ++i) {
+    outer[i] = (int) i;
+  }
+  for (size_t i = 0U; i != inner.len(); ++i) {
+    inner[i] = (int) i;
+  }
+
+  // The default order stays lexicographic whatever the size
+  size_t index = 0U;
+  for (auto[o, i] : outer.iter().cartesian_product(inner.iter())) {
+    ASSERT((size_t) o * inner.len() + (size_t) i == index);
+    ++index;
+  }
+  ASSERT(index == 30000);
+
+  auto product = outer.iter().cartesian_product_blocked(inner.iter());
+  ASSERT(product.len() == 30000);
+
+  // Every pair is still yielded exactly once
+  Array<int> seen{30000};
+  memset(&seen[0], 0, seen.len() * sizeof(int));
+  index = 0U;
+  for (auto[o, i] : outer.iter().cartesian_product_blocked(inner.iter())) {
+    ++seen[(size_t) o * inner.len() + (size_t) i];
+    ++index;
+  }
+  ASSERT(index == 30000);
+  ASSERT(seen.iter().all([](const int &v) { return v == 1; }));
+
+  // A block holds 4096 ints, and all the outer items go through it before the next one starts
+  auto next_block = product[3U * 4096U];
+  ASSERT(next_block.first == 0 && next_block.second == 4096);
+
+  for (size_t n = 0U; n < 30000U; n += 997U) {
+    auto expected = outer.iter().cartesian_product_blocked(inner.iter())[n];
+    auto v = outer.iter().cartesian_product_blocked(inner.iter()).nth(n);
+    ASSERT(v->first == expected.first && v->second == expected.second);
+    auto lexicographic = outer.iter().cartesian_product(inner.iter()).nth(n);
+    ASSERT((size_t) lexicographic->first == n / inner.len() && (size_t) lexicographic->second == n % inner.len());
+  }
+  ASSERT(product.advance_by(40000) == 30000);
+  ASSERT(!product.next().has_value());
+
+  TEST_PASSED();
+}
+
+template<typename IteratorType>
+Array<int> flatten_ints(IteratorType iter) {
+  Array<int> res{iter.len() * 3};
+  size_t i = 0U;
+  for (const auto &items : iter) {
+    for (int v : items) {
+      res[i++] = v;
+    }
+  }
+  return res;
+}
+
+UNIT_TEST(combinations_works) {
+  Array<int> ints{4};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i + 1;
+  }
+
+  auto pairs = ints.iter().combinations(2);
+  ASSERT(pairs.len() == 6);
+  auto first = pairs.next();
+  ASSERT(first->get().size() == 2 && first->get()[0] == 1 && first->get()[1] == 2);
+  ASSERT(pairs.size_hint().second == 5U);
+  auto sums = pairs
+      .map([](const std::vector<std::reference_wrapper<int>> &c) { return c[0] + c[1]; })
+      .collect<Array>();
+  ASSERT(sums.len() == 5);
+  ASSERT(sums[0] == 4 && sums[1] == 5 && sums[2] == 5 && sums[3] == 6 && sums[4] == 7);
+
+  auto triples = flatten_ints(ints.iter().combinations(3));
+  int expected_triples[] = {1, 2, 3, 1, 2, 4, 1, 3, 4, 2, 3, 4};
+  for (size_t i = 0U; i != triples.len(); ++i) {
+    ASSERT(triples[i] == expected_triples[i]);
+  }
+
+  ASSERT(ints.iter().combinations(0).count() == 1);
+  ASSERT(ints.iter().combinations(4).count() == 1);
+  ASSERT(ints.iter().combinations(5).count() == 0);
+  ASSERT(ints.iter().skip(1).combinations(2).count() == 3);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(combinations_with_replacement_works) {
+  Array<int> ints{3};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i + 1;
+  }
+
+  auto iter = ints.iter().combinations_with_replacement(2);
+  ASSERT(iter.len() == 6);
+  Array<int> flat{12};
+  size_t i = 0U;
+  for (const auto &items : iter) {
+    flat[i++] = items[0];
+    flat[i++] = items[1];
+  }
+  int expected[] = {1, 1, 1, 2, 1, 3, 2, 2, 2, 3, 3, 3};
+  for (size_t j = 0U; j != flat.len(); ++j) {
+    ASSERT(flat[j] == expected[j]);
+  }
+
+  ASSERT(ints.iter().combinations_with_replacement(3).count() == 10);
+  ASSERT(ints.iter().combinations_with_replacement(0).count() == 1);
+  ASSERT(Array<int>{}.iter().combinations_with_replacement(2).count() == 0);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(permutations_works) {
+  Array<int> ints{3};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i + 1;
+  }
+
+  auto iter = ints.iter().permutations(2);
+  ASSERT(iter.len() == 6);
+  Array<int> flat{12};
+  size_t i = 0U;
+  for (const auto &items : iter) {
+    flat[i++] = items[0];
+    flat[i++] = items[1];
+  }
+  int expected[] = {1, 2, 1, 3, 2, 1, 2, 3, 3, 1, 3, 2};
+  for (size_t j = 0U; j != flat.len(); ++j) {
+    ASSERT(flat[j] == expected[j]);
+  }
+
+  auto full = flatten_ints(ints.iter().permutations(3));
+  int expected_full[] = {1, 2, 3, 1, 3, 2, 2, 1, 3, 2, 3, 1, 3, 1, 2, 3, 2, 1};
+  for (size_t j = 0U; j != full.len(); ++j) {
+    ASSERT(full[j] == expected_full[j]);
+  }
+
+  ASSERT(ints.iter().permutations(0).count() == 1);
+  ASSERT(ints.iter().permutations(4).count() == 0);
+
+  Array<int> more{6};
+  ASSERT(more.iter().permutations(4).count() == 360);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(combination_masks_works) {
+  Array<int> ints{4};
+
+  auto masks = combination_masks(ints.len(), 2).collect<Array>();
+  uint64_t expected[] = {0b0011, 0b0101, 0b0110, 0b1001, 0b1010, 0b1100};
+  ASSERT(masks.len() == 6);
+  for (size_t i = 0U; i != masks.len(); ++i) {
+    ASSERT(masks[i] == expected[i]);
+  }
+
+  ASSERT(combination_masks(ints.len(), 0).count() == 1);
+  ASSERT(combination_masks(ints.len(), 5).count() == 0);
+
+  Array<int> wide{64};
+  auto all = combination_masks(wide.len(), 64);
+  ASSERT(*all.next() == ~uint64_t{0});
+  ASSERT(!all.next().has_value());
+  ASSERT(combination_masks(wide.len(), 2).len() == 2016);
+  ASSERT(*combination_masks(wide.len(), 1).nth(63) == uint64_t{1} << 63U);
+  ASSERT(combination_masks(wide.len(), 32).len() == 1832624140942590534U);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(position_works) {
+  Array<int> ints{6};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i % 3;
+  }
+
+  // ints is: [0, 1, 2, 0, 1, 2]
+
+  auto iter = ints.iter();
+  ASSERT(*iter.position([](const int &v) { return v == 2; }) == 2);
+  ASSERT(*iter.position([](const int &v) { return v == 2; }) == 2);
+  ASSERT(!iter.position([](const int &v) { return v == 2; }).has_value());
+
+  ASSERT(*ints.iter().rposition([](const int &v) { return v == 1; }) == 4);
+  ASSERT(*ints.iter().rposition([](const int &v) { return v == 0; }) == 3);
+  ASSERT(!ints.iter().rposition([](const int &v) { return v == 3; }).has_value());
+
+  auto filtered = ints.iter().filter([](const int &v) { return v != 0; });
+  ASSERT(*filtered.position([](const int &v) { return v == 2; }) == 1);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(position_of_works) {
+  Array<int> ints{100};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  for (int v = 0; v < 100; v += 7) {
+    ASSERT(*ints.iter().position_of(v) == (size_t) v);
+  }
+  ASSERT(!ints.iter().position_of(100).has_value());
+
+  auto iter = ints.iter();
+  iter.advance_by(10);
+  ASSERT(*iter.position_of(50) == 40);
+  ASSERT(*iter.next() == 51);
+  ASSERT(!iter.position_of(50).has_value());
+  ASSERT(!iter.next().has_value());
+
+  Array<char> line{15};
+  memcpy(&line[0], "GET /index.html", 15);
+  ASSERT(*line.iter().position_of(' ') == 3);
+  ASSERT(*line.iter().position_of('.') == 10);
+  ASSERT(!line.iter().position_of('?').has_value());
+
+  ASSERT(*ints.iter().map([](const int &v) { return v * 2; }).position_of(50) == 25);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(fold_into_any_type_works) {
+  Array<std::string> words{3};
+  words[0] = "a";
+  words[1] = "bb";
+  words[2] = "ccc";
+
+  size_t total = words.iter().fold(size_t{0}, [](size_t acc, const std::string &w) { return acc + w.size(); });
+  ASSERT(total == 6);
+
+  std::string csv = words.iter().fold(std::string{}, [](std::string acc, const std::string &w) {
+    acc += w;
+    acc += ',';
+    return acc;
+  });
+  ASSERT(csv == "a,bb,ccc,");
+
+  // The accumulator is moved through, so its buffer is reused
+  std::string big{};
+  big.reserve(64);
+  const char *buffer = big.data();
+  std::string res = words.iter().fold(std::move(big), [](std::string acc, const std::string &w) {
+    acc += w;
+    return acc;
+  });
+  ASSERT(res == "abbccc");
+  ASSERT(res.data() == buffer);
+
+  int counted = words.iter().fold(0, [](int &acc, const std::string &) { return acc + 1; });
+  ASSERT(counted == 3);
+
+  // An int can't bind to double &, so the accumulator is the item type, like it always was
+  Array<double> doubles{3};
+  doubles[0] = 0.5;
+  doubles[1] = 1.25;
+  doubles[2] = 2.0;
+  auto sum = doubles.iter().fold(0, [](double &acc, const double &v) { return acc + v; });
+  static_assert(std::is_same_v<decltype(sum), double>);
+  ASSERT(sum == 3.75);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(reduce_works) {
+  Array<int> ints{4};
+  ints[0] = 3;
+  ints[1] = 7;
+  ints[2] = 1;
+  ints[3] = 5;
+
+  auto max = ints.iter().reduce([](int acc, const int &v) { return acc > v ? acc : v; });
+  ASSERT(max.has_value() && *max == 7);
+  ASSERT(*ints.iter().reduce([](int acc, const int &v) { return acc + v; }) == 16);
+  ASSERT(!Array<int>{}.iter().reduce([](int acc, const int &v) { return acc + v; }).has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_fold_works) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i + 1;
+  }
+
+  auto checked_add = [](int acc, const int &v) -> std::optional<int> {
+    if (acc + v > 6) {
+      return std::nullopt;
+    }
+    return acc + v;
+  };
+
+  auto iter = ints.iter();
+  ASSERT(!iter.try_fold(0, checked_add).has_value());
+  // It stopped at 4, the item that made the sum too big
+  ASSERT(*iter.next() == 5);
+
+  auto small = ints.iter().take(3).try_fold(0, checked_add);
+  ASSERT(small.has_value() && *small == 6);
+
+  auto empty = Array<int>{}.iter().try_fold(42, checked_add);
+  ASSERT(empty.has_value() && *empty == 42);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(for_each_consumes_the_iterator) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i;
+  }
+
+  int sum = 0;
+  auto iter = ints.iter();
+  iter.for_each([&sum](const int &v) { sum += v; });
+  ASSERT(sum == 10);
+  ASSERT(!iter.next().has_value());
+
+  sum = 0;
+  auto filtered = ints.iter().filter([](const int &v) { return v % 2 == 0; });
+  filtered.for_each([&sum](const int &v) { sum += v; });
+  ASSERT(sum == 6);
+  ASSERT(!filtered.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_for_each_works) {
+  Array<int> ints{6};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i + 1;
+  }
+
+  int sum = 0;
+  auto add_until_four = [&sum](const int &v) {
+    if (v == 4) {
+      return ControlFlow::Break;
+    }
+    sum += v;
+    return ControlFlow::Continue;
+  };
+
+  auto iter = ints.iter();
+  ASSERT(iter.try_for_each(add_until_four) == ControlFlow::Break);
+  ASSERT(sum == 6);
+  // The item that broke the loop is consumed, the ones after it aren't
+  ASSERT(*iter.next() == 5);
+
+  sum = 0;
+  auto odds = ints.iter().filter([](const int &v) { return v % 2 == 1; });
+  ASSERT(odds.try_for_each(add_until_four) == ControlFlow::Continue);
+  ASSERT(sum == 9);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(for_each_while_works) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = 10 * (i + 1);
+  }
+
+  int budget = 65;
+  auto spend = [&budget](const int &cost) {
+    if (cost > budget) {
+      return false;
+    }
+    budget -= cost;
+    return true;
+  };
+
+  auto iter = ints.iter();
+  ASSERT(!iter.for_each_while(spend));
+  ASSERT(budget == 5);
+  ASSERT(*iter.next() == 50);
+
+  budget = 1000;
+  ASSERT(ints.iter().map([](const int &v) { return v / 10; }).for_each_while(spend));
+  ASSERT(budget == 985);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(for_each_reads_zip_and_rev_once) {
+  Array<int> ints{4};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i + 1;
+  }
+
+  size_t calls = 0U;
+  auto doubled = [&calls](const int &v) {
+    ++calls;
+    return v * 2;
+  };
+
+  int sum = 0;
+  auto zipped = ints.iter().zip(ints.iter().map(doubled));
+  zipped.for_each([&sum](const std::pair<std::reference_wrapper<int>, int> &pair) { sum += pair.first * pair.second; });
+  ASSERT(sum == 60);
+  ASSERT(calls == 4U);
+  ASSERT(!zipped.next().has_value());
+
+  calls = 0U;
+  auto reversed = ints.iter().rev().zip(ints.iter().map(doubled));
+  auto until_three = [](const std::pair<std::reference_wrapper<int>, int> &pair) {
+    return pair.first == 3 ? ControlFlow::Break : ControlFlow::Continue;
+  };
+  ASSERT(reversed.try_for_each(until_three) == ControlFlow::Break);
+  ASSERT(calls == 2U);
+  ASSERT(reversed.next()->first == 2);
+  ASSERT(calls == 3U);
+
+  auto rev = ints.iter().rev();
+  ASSERT(rev.advance_by(3) == 3U);
+  ASSERT(*rev.next() == 1);
+  ASSERT(!rev.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(map_is_called_for_skipped_items) {
+  Array<int> ints{6};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = i;
+  }
+
+  size_t calls = 0U;
+  auto counted = [&calls](const int &v) {
+    ++calls;
+    return v;
+  };
+
+  ASSERT(*ints.iter().map(counted).nth(3) == 3);
+  ASSERT(calls == 4U);
+
+  calls = 0U;
+  ASSERT(ints.iter().map(counted).skip(2).step_by(2).count() == 2U);
+  ASSERT(calls == 6U);
+
+  // Reading by index only maps the items that are read
+  calls = 0U;
+  int sum = 0;
+  ints.iter().map(counted).skip(2).step_by(2).for_each([&sum](const int &v) { sum += v; });
+  ASSERT(sum == 6);
+  ASSERT(calls == 2U);
+
+  TEST_PASSED();
+}
+
 TestFn tests[] = {
     test_step_by_works,
     test_map_works,
@@ -617,7 +1259,28 @@ TestFn tests[] = {
     test_fold_works,
     test_join_works,
     test_count_works,
-    test_collect_works
+    test_collect_works,
+    test_rle_works,
+    test_nth_works,
+    test_prefetch_works,
+    test_zip_reduce_works,
+    test_dot_works,
+    test_cartesian_product_works,
+    test_cartesian_product_blocked_works,
+    test_combinations_works,
+    test_combinations_with_replacement_works,
+    test_permutations_works,
+    test_combination_masks_works,
+    test_position_works,
+    test_position_of_works,
+    test_fold_into_any_type_works,
+    test_reduce_works,
+    test_try_fold_works,
+    test_for_each_consumes_the_iterator,
+    test_try_for_each_works,
+    test_for_each_while_works,
+    test_for_each_reads_zip_and_rev_once,
+    test_map_is_called_for_skipped_items
 };
 
 int main() {
@@ -0,0 +1,131 @@
+#include <array>
+#include "../unit_test.h"
+#include "../data_structures/array.h"
+#include "../data_structures/matrix.h"
+
+UNIT_TEST(matrix_layout_works) {
+  Matrix<int> empty{};
+  ASSERT(empty.num_rows() == 0 && empty.num_cols() == 0);
+  ASSERT(!empty.rows().next().has_value());
+
+  Matrix<int> m(3, 5);
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    for (size_t j = 0U; j != m.num_cols(); ++j) {
+      m(i, j) = (int) (i * m.num_cols() + j);
+    }
+  }
+  ASSERT(m.num_rows() == 3);
+  ASSERT(m.num_cols() == 5);
+  ASSERT(m.stride() == 16);
+
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    ASSERT(reinterpret_cast<uintptr_t>(&m(i, 0)) % Matrix<int>::ALIGNMENT == 0);
+  }
+
+  auto copy = m;
+  copy(1, 1) = -1;
+  ASSERT(m(1, 1) == 6);
+
+  // 24 byte items don't divide a cache line, 8 of them fill 3 lines
+  Matrix<std::array<double, 3>> points(3, 5);
+  ASSERT(points.stride() == 8);
+  for (size_t i = 0U; i != points.num_rows(); ++i) {
+    ASSERT(reinterpret_cast<uintptr_t>(&points(i, 0)) % Matrix<int>::ALIGNMENT == 0);
+  }
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(matrix_rows_and_cols_work) {
+  Matrix<int> m(3, 5);
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    for (size_t j = 0U; j != m.num_cols(); ++j) {
+      m(i, j) = (int) (i * m.num_cols() + j);
+    }
+  }
+
+  auto row_sums = m.rows()
+      .map([](SliceIterator<int> row) { return row.sum(); })
+      .collect<Array>();
+  ASSERT(row_sums.len() == 3);
+  ASSERT(row_sums[0] == 10 && row_sums[1] == 35 && row_sums[2] == 60);
+
+  auto col_sums = m.cols()
+      .map([](StridedIterator<int> col) { return col.sum(); })
+      .collect<Array>();
+  ASSERT(col_sums.len() == 5);
+  for (size_t j = 0U; j != 5; ++j) {
+    ASSERT(col_sums[j] == (int) (15 + 3 * j));
+  }
+
+  ASSERT(m.cols().len() == 5);
+  ASSERT(m.cols()[4].sum() == 27);
+  ASSERT(m.rows().next_back()->sum() == 60);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(matrix_tiles_work) {
+  Matrix<int> m(5, 7);
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    for (size_t j = 0U; j != m.num_cols(); ++j) {
+      m(i, j) = (int) (i * m.num_cols() + j);
+    }
+  }
+
+  auto tiles = m.tiles(2, 3);
+  ASSERT(tiles.len() == 9);
+
+  size_t visited = 0U;
+  int sum = 0;
+  for (const auto &tile : m.tiles(2, 3)) {
+    visited += tile.iter().count();
+    sum += tile.iter().sum();
+    ASSERT(tile(0, 0) == m(tile.row_offset, tile.col_offset));
+  }
+  ASSERT(visited == 35);
+  ASSERT(sum == 34 * 35 / 2);
+
+  auto last = tiles[8];
+  ASSERT(last.row_offset == 4 && last.col_offset == 6);
+  ASSERT(last.height == 1 && last.width == 1);
+
+  auto second = tiles[1];
+  auto items = second.iter().map([](const int &v) { return v; }).collect<Array>();
+  ASSERT(items.len() == 6);
+  ASSERT(items[0] == 3 && items[2] == 5 && items[3] == 10 && items[5] == 12);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(matrix_transpose_works) {
+  Matrix<int> m(37, 21);
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    for (size_t j = 0U; j != m.num_cols(); ++j) {
+      m(i, j) = (int) (i * m.num_cols() + j);
+    }
+  }
+
+  Matrix<int> t{};
+  m.transpose_into(t);
+  ASSERT(t.num_rows() == 21 && t.num_cols() == 37);
+  for (size_t i = 0U; i != m.num_rows(); ++i) {
+    for (size_t j = 0U; j != m.num_cols(); ++j) {
+      ASSERT(t(j, i) == m(i, j));
+    }
+  }
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_matrix_layout_works,
+    test_matrix_rows_and_cols_work,
+    test_matrix_tiles_work,
+    test_matrix_transpose_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -0,0 +1,147 @@
+#include "../unit_test.h"
+#include "../data_structures/packed_array.h"
+
+template<typename T>
+bool packed_cmp_eq(const PackedArray<T> &packed, const Array<T> &expected) {
+  if (packed.len() != expected.len()) {
+    return false;
+  }
+
+  size_t i = 0U;
+  for (T v : packed.iter()) {
+    if (v != expected[i]) {
+      return false;
+    }
+    ++i;
+  }
+
+  return i == expected.len();
+}
+
+UNIT_TEST(packed_array_default_ctor_works) {
+  PackedArray<uint64_t> packed{};
+  ASSERT(packed.len() == 0);
+  ASSERT(!packed.iter().next().has_value());
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_frame_of_reference_works) {
+  Array<uint64_t> ids{1000};
+  for (size_t i = 0U; i != ids.len(); ++i) {
+    ids[i] = 1000000U + (i * 7919U) % 1000U;
+  }
+
+  PackedArray<uint64_t> packed(ids);
+  ASSERT(packed_cmp_eq(packed, ids));
+  ASSERT(packed.packed_bytes() < ids.len() * sizeof(uint64_t) / 4);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_delta_works) {
+  Array<uint64_t> timestamps{300};
+  for (size_t i = 0U; i != timestamps.len(); ++i) {
+    timestamps[i] = 1600000000U + i * 3U;
+  }
+
+  PackedArray<uint64_t> packed(timestamps, PackedArray<uint64_t>::Encoding::Delta);
+  ASSERT(packed_cmp_eq(packed, timestamps));
+  ASSERT(packed.packed_bytes() < timestamps.len());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_signed_values_work) {
+  Array<int32_t> ints{200};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (i % 2 ? -1 : 1) * (int32_t) (i * 1000003U);
+  }
+  ints[17] = INT32_MIN;
+  ints[18] = INT32_MAX;
+
+  ASSERT(packed_cmp_eq(PackedArray<int32_t>(ints), ints));
+  ASSERT(packed_cmp_eq(PackedArray<int32_t>(ints, PackedArray<int32_t>::Encoding::Delta), ints));
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_advance_by_works) {
+  Array<int> ints{1000};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  PackedArray<int> packed(ints, PackedArray<int>::Encoding::Delta);
+
+  auto iter = packed.iter();
+  ASSERT(iter.advance_by(5) == 5);
+  ASSERT(*iter.next() == 5);
+  ASSERT(iter.advance_by(300) == 300);
+  ASSERT(*iter.next() == 306);
+  ASSERT(iter.advance_by(149) == 149);
+  ASSERT(*iter.next() == 456);
+  ASSERT(iter.advance_by(1000) == 543);
+  ASSERT(!iter.next().has_value());
+
+  ASSERT(packed.iter().skip(990).sum() == 9945);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_advance_by_past_partial_block) {
+  Array<int> ints{130};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  PackedArray<int> packed(ints, PackedArray<int>::Encoding::Delta);
+
+  // Lands inside the partial last block, with one item left
+  auto iter = packed.iter();
+  ASSERT(iter.advance_by(129) == 129);
+  ASSERT(iter.advance_by(5) == 1);
+  ASSERT(!iter.next().has_value());
+  ASSERT(iter.advance_by(5) == 0);
+  ASSERT(!iter.next().has_value());
+
+  auto drained = packed.iter();
+  ASSERT(drained.advance_by(129) == 129);
+  ASSERT(*drained.next() == 129);
+  ASSERT(drained.advance_by(5) == 0);
+  ASSERT(!drained.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(packed_array_zero_width_blocks_work) {
+  Array<uint32_t> same{300};
+  for (size_t i = 0U; i != same.len(); ++i) {
+    same[i] = 42U;
+  }
+
+  PackedArray<uint32_t> packed(same);
+  ASSERT(packed_cmp_eq(packed, same));
+  ASSERT(packed.iter().skip(250).sum() == 42U * 50U);
+
+  PackedArray<uint32_t> empty(Array<uint32_t>{});
+  ASSERT(empty.len() == 0);
+  ASSERT(empty.packed_bytes() == 0);
+  ASSERT(!empty.iter().next().has_value());
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_packed_array_default_ctor_works,
+    test_packed_array_frame_of_reference_works,
+    test_packed_array_delta_works,
+    test_packed_array_signed_values_work,
+    test_packed_array_advance_by_works,
+    test_packed_array_advance_by_past_partial_block,
+    test_packed_array_zero_width_blocks_work
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
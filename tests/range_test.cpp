@@ -5,8 +5,8 @@
 UNIT_TEST(range_iteration_works) {
   Range<size_t> range{1, 10};
   size_t i = 1U;
-  foreach(it, range.iter()) {
-    ASSERT(i == *it);
+  for (size_t v : range.iter()) {
+    ASSERT(i == v);
     ++i;
   }
   TEST_PASSED();
@@ -16,8 +16,8 @@ UNIT_TEST(range_map_works) {
   Range<int> range{1, 10};
 
   size_t i = 1U;
-  foreach(it, range.iter().map([](const int &v) { return v * v; })) {
-    ASSERT(i * i == *it);
+  for (int v : range.iter().map([](const int &v) { return v * v; })) {
+    ASSERT(i * i == v);
     ++i;
   }
 
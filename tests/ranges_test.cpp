@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include "../unit_test.h"
+#include "../data_structures/array.h"
+#include "../data_structures/range.h"
+#include "../iter_from.h"
+#include "../ranges.h"
+
+UNIT_TEST(as_view_is_random_access_for_arrays) {
+  Array<int> ints{5};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) (ints.len() - i);
+  }
+
+  auto view = as_view(ints.iter());
+  static_assert(std::ranges::random_access_range<decltype(view)>);
+  static_assert(std::ranges::sized_range<decltype(view)>);
+  static_assert(std::ranges::view<decltype(view)>);
+
+  ASSERT(view.size() == 5);
+  std::sort(view.begin(), view.end());
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ASSERT(ints[i] == (int) i + 1);
+  }
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(as_view_works_with_parallel_algorithms) {
+  Array<int> ints{1000};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints[i] = (int) i;
+  }
+
+  auto squares = as_view(ints.iter().skip(1).map([](const int &v) { return (long) v * v; }));
+  static_assert(std::ranges::random_access_range<decltype(squares)>);
+  ASSERT(squares.size() == 999);
+
+  long sum = std::reduce(std::execution::par, squares.begin(), squares.end(), 0L);
+  ASSERT(sum == 332833500L);
+
+  auto pairs = as_view(ints.iter().zip(ints.iter().rev()).take(3));
+  ASSERT(pairs.size() == 3);
+  ASSERT(pairs[2].first == 2 && pairs[2].second == 997);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(as_view_is_input_range_otherwise) {
+  Range<int> range{1, 10};
+
+  auto evens = as_view(range.iter().filter([](const int &v) { return v % 2 == 0; }));
+  static_assert(std::ranges::input_range<decltype(evens)>);
+  static_assert(!std::ranges::forward_range<decltype(evens)>);
+
+  int expected = 2;
+  for (int v : evens | std::views::take(3)) {
+    ASSERT(v == expected);
+    expected += 2;
+  }
+  ASSERT(expected == 8);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(iter_from_span_works) {
+  int ints[] = {1, 2, 3, 4, 5};
+
+  std::span<int> dynamic(ints);
+  auto iter = iter_from(dynamic);
+  ASSERT(iter.len() == 5);
+  ASSERT(*iter.next_back() == 5);
+  ASSERT(iter.skip(1).sum() == 9);
+
+  std::span<const int, 3> fixed(ints + 1, 3);
+  ASSERT(iter_from(fixed).sum() == 9);
+
+  // Writes go through to the memory the span views
+  iter_from(dynamic).for_each([](int &v) { v *= 2; });
+  ASSERT(ints[4] == 10);
+
+  ASSERT(iter_from(std::span<int>{}).count() == 0);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_as_view_is_random_access_for_arrays,
+    test_as_view_works_with_parallel_algorithms,
+    test_as_view_is_input_range_otherwise,
+    test_iter_from_span_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
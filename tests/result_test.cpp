@@ -0,0 +1,182 @@
+#include <string>
+#include "../unit_test.h"
+#include "../text.h"
+#include "../data_structures/array.h"
+
+enum class ParseError {
+  Empty,
+  NotANumber
+};
+
+Result<int, ParseError> parse_int(const std::string_view &token) {
+  if (token.empty()) {
+    return Err{ParseError::Empty};
+  }
+  int value = 0;
+  auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+  if (error != std::errc{} || end != token.data() + token.size()) {
+    return Err{ParseError::NotANumber};
+  }
+  return value;
+}
+
+UNIT_TEST(result_works) {
+  Result<int, ParseError> ok = 7;
+  ASSERT(ok.is_ok());
+  ASSERT(ok);
+  ASSERT(*ok == 7);
+  ASSERT(ok.value_or(0) == 7);
+
+  Result<int, ParseError> err = Err{ParseError::Empty};
+  ASSERT(err.is_err());
+  ASSERT(!err);
+  ASSERT(err.error() == ParseError::Empty);
+  ASSERT(err.value_or(0) == 0);
+
+  Result<std::string, std::string> same = Err{std::string("bad")};
+  ASSERT(same.is_err());
+  ASSERT(same.error() == "bad");
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_map_stops_at_first_error) {
+  size_t calls = 0U;
+  auto counted_parse = [&calls](const std::string_view &token) {
+    ++calls;
+    return parse_int(token);
+  };
+
+  auto iter = split("1,2,x,4", ',').try_map(counted_parse);
+  ASSERT(*iter.next().value() == 1);
+  ASSERT(*iter.next().value() == 2);
+  ASSERT(iter.next().value().error() == ParseError::NotANumber);
+  ASSERT(!iter.next().has_value());
+  ASSERT(calls == 3U);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_map_chains) {
+  auto halve = [](const int &v) -> Result<int, ParseError> {
+    if (v % 2 != 0) {
+      return Err{ParseError::NotANumber};
+    }
+    return v / 2;
+  };
+
+  auto ok = split("2,4,6", ',').try_map(parse_int).try_map(halve).try_collect<Array>();
+  ASSERT(ok.is_ok());
+  ASSERT(ok->len() == 3);
+  ASSERT((*ok)[0] == 1 && (*ok)[1] == 2 && (*ok)[2] == 3);
+
+  // The error of the first try_map goes through the second one
+  auto first = split("2,,3", ',').try_map(parse_int).try_map(halve).try_collect<Array>();
+  ASSERT(first.is_err() && first.error() == ParseError::Empty);
+
+  auto second = split("2,3,", ',').try_map(parse_int).try_map(halve).try_collect<Array>();
+  ASSERT(second.is_err() && second.error() == ParseError::NotANumber);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_filter_works) {
+  auto positive = [](const int &v) -> Result<bool, ParseError> {
+    if (v == 0) {
+      return Err{ParseError::NotANumber};
+    }
+    return v > 0;
+  };
+
+  Array<int> ints{5};
+  ints[0] = 3;
+  ints[1] = -1;
+  ints[2] = 4;
+  ints[3] = 0;
+  ints[4] = 5;
+
+  auto iter = ints.iter().try_filter(positive);
+  ASSERT(*iter.next().value() == 3);
+  ASSERT(*iter.next().value() == 4);
+  ASSERT(iter.next().value().is_err());
+  ASSERT(!iter.next().has_value());
+
+  auto kept = ints.iter().take(3).try_filter(positive).try_collect<Array>();
+  ASSERT(kept.is_ok());
+  ASSERT(kept->len() == 2);
+  ASSERT((*kept)[0] == 3 && (*kept)[1] == 4);
+
+  auto parsed = split("7,-2,8", ',').try_map(parse_int).try_filter(positive).try_collect<Array>();
+  ASSERT(parsed.is_ok() && parsed->len() == 2);
+  ASSERT((*parsed)[1] == 8);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_collect_works) {
+  auto ok = split("10,20,30", ',').try_map(parse_int).try_collect<Array>();
+  ASSERT(ok.is_ok());
+  ASSERT(ok->iter().sum() == 60);
+
+  auto empty = split("", ',').try_map(parse_int).try_collect<Array>();
+  ASSERT(empty.is_err() && empty.error() == ParseError::Empty);
+
+  auto err = split("10,y,30", ',').try_map(parse_int).try_collect<Array>();
+  ASSERT(err.is_err());
+  ASSERT(err.error() == ParseError::NotANumber);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_fold_works_with_result) {
+  auto checked_sum = split("1,2,3", ',')
+      .try_map(parse_int)
+      .try_fold(0, [](int acc, const Result<int, ParseError> &v) -> Result<int, ParseError> {
+        if (!v) {
+          return Err{v.error()};
+        }
+        return acc + *v;
+      });
+  ASSERT(checked_sum.is_ok() && *checked_sum == 6);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_for_each_works_with_result) {
+  int sum = 0;
+  auto add = [&sum](const std::string_view &token) -> Result<int, ParseError> {
+    auto v = parse_int(token);
+    if (v) {
+      sum += *v;
+    }
+    return v;
+  };
+
+  auto iter = split("1,2,x,4", ',');
+  std::optional<ParseError> error = iter.try_for_each(add);
+  ASSERT(error.has_value() && *error == ParseError::NotANumber);
+  ASSERT(sum == 3);
+  // The item after the error isn't consumed
+  ASSERT(*iter.next() == "4");
+
+  sum = 0;
+  ASSERT(!split("1,2,3", ',').try_for_each(add).has_value());
+  ASSERT(sum == 6);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_result_works,
+    test_try_map_stops_at_first_error,
+    test_try_map_chains,
+    test_try_filter_works,
+    test_try_collect_works,
+    test_try_fold_works_with_result,
+    test_try_for_each_works_with_result
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
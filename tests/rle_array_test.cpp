@@ -0,0 +1,99 @@
+#include "../unit_test.h"
+#include "../data_structures/rle_array.h"
+
+UNIT_TEST(rle_array_default_ctor_works) {
+  RleArray<int> rle{};
+  ASSERT(rle.len() == 0);
+  ASSERT(rle.num_runs() == 0);
+  ASSERT(!rle.iter().next().has_value());
+  TEST_PASSED();
+}
+
+UNIT_TEST(rle_array_iteration_works) {
+  Array<int> status{10};
+  status[0] = 1;
+  status[1] = 1;
+  status[2] = 1;
+  status[3] = 2;
+  status[4] = 2;
+  status[5] = 1;
+  status[6] = 3;
+  status[7] = 3;
+  status[8] = 3;
+  status[9] = 3;
+
+  RleArray<int> rle(status);
+
+  ASSERT(rle.len() == 10);
+  ASSERT(rle.num_runs() == 4);
+
+  size_t i = 0U;
+  for (int v : rle.iter()) {
+    ASSERT(v == status[i]);
+    ++i;
+  }
+  ASSERT(i == status.len());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(rle_array_count_and_sum_work) {
+  Array<int> status{5};
+  status[0] = 1;
+  status[1] = 1;
+  status[2] = 2;
+  status[3] = 2;
+  status[4] = 2;
+
+  RleArray<int> rle(status);
+  ASSERT(rle.iter().count() == 5);
+  ASSERT(rle.iter().sum() == 8);
+
+  // Starting in the middle of the first run
+  auto iter = rle.iter();
+  iter.next();
+  auto copy = iter;
+  ASSERT(copy.count() == 4);
+  ASSERT(iter.sum() == 7);
+  ASSERT(!iter.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(rle_array_nth_works) {
+  Array<int> status{6};
+  status[0] = 1;
+  status[1] = 1;
+  status[2] = 2;
+  status[3] = 3;
+  status[4] = 3;
+  status[5] = 3;
+
+  RleArray<int> rle(status);
+
+  for (size_t i = 0U; i != status.len(); ++i) {
+    auto v = rle.iter().nth(i);
+    ASSERT(v.has_value() && *v == status[i]);
+  }
+  ASSERT(!rle.iter().nth(6).has_value());
+
+  auto iter = rle.iter();
+  ASSERT(*iter.nth(2) == 2);
+  ASSERT(*iter.nth(0) == 3);
+  ASSERT(*iter.next() == 3);
+  ASSERT(iter.count() == 1);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_rle_array_default_ctor_works,
+    test_rle_array_iteration_works,
+    test_rle_array_count_and_sum_work,
+    test_rle_array_nth_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -0,0 +1,147 @@
+#include "../unit_test.h"
+#include "../data_structures/shared_array.h"
+
+UNIT_TEST(shared_array_default_ctor_works) {
+  SharedArray<int> ints{};
+  ASSERT(ints.len() == 0);
+  ASSERT(ints.use_count() == 0);
+  ASSERT(!ints.iter().next().has_value());
+
+  ints.make_mut();
+  ASSERT(ints.is_unique());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(shared_array_clone_shares_buffer) {
+  SharedArray<int> ints{10};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints.set(i, (int) i);
+  }
+  ASSERT(ints.is_unique());
+
+  auto copy = ints.clone();
+  SharedArray<int> assigned{};
+  assigned = copy;
+  ASSERT(ints.use_count() == 3);
+  ASSERT(&copy[0] == &ints[0]);
+  ASSERT(&assigned[0] == &ints[0]);
+
+  {
+    auto scoped = ints;
+    ASSERT(ints.use_count() == 4);
+  }
+  ASSERT(ints.use_count() == 3);
+
+  auto moved = std::move(assigned);
+  ASSERT(ints.use_count() == 3);
+  ASSERT(assigned.len() == 0);
+  ASSERT(moved.iter().sum() == 45);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(shared_array_copies_on_write) {
+  SharedArray<int> ints{10};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints.set(i, (int) i);
+  }
+  auto snapshot = ints.clone();
+
+  ints.set(0, 100);
+  ASSERT(ints[0] == 100);
+  ASSERT(snapshot[0] == 0);
+  ASSERT(ints.is_unique() && snapshot.is_unique());
+  ASSERT(&ints[0] != &snapshot[0]);
+
+  // The buffer is not shared anymore, so writes happen in place
+  const int *before = &ints[0];
+  ints.iter_mut().for_each([](int &v) { v *= 2; });
+  ASSERT(&ints[0] == before);
+  ASSERT(ints.iter().sum() == 200 + 90);
+  ASSERT(snapshot.iter().sum() == 45);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(shared_array_collect_works) {
+  Array<int> items{5};
+  for (size_t i = 0U; i != items.len(); ++i) {
+    items[i] = (int) i;
+  }
+
+  SharedArray<int> ints(std::move(items));
+  auto doubled = ints.iter()
+      .map([](const int &v) { return v * 2; })
+      .collect<SharedArray>();
+  ASSERT(doubled.len() == 5);
+  ASSERT(doubled[4] == 8);
+
+  TEST_PASSED();
+}
+
+template<typename IteratorType, typename = void>
+struct can_write_through : std::false_type {};
+
+template<typename IteratorType>
+struct can_write_through<IteratorType, std::void_t<decltype(std::declval<IteratorType &>().next()->get() = 0)>>
+    : std::true_type {};
+
+UNIT_TEST(shared_array_iter_is_read_only) {
+  SharedArray<int> ints{10};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints.set(i, (int) i);
+  }
+  auto snapshot = ints.clone();
+
+  // Writing through iter would change every copy, so it doesn't compile
+  static_assert(!can_write_through<decltype(snapshot.iter())>::value);
+  static_assert(can_write_through<decltype(ints.iter_mut())>::value);
+
+  snapshot.iter_mut().for_each([](int &v) { v = -1; });
+  ASSERT(snapshot.iter().sum() == -10);
+  ASSERT(ints.iter().sum() == 45);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(shared_array_borrows_are_not_shared) {
+  SharedArray<int> ints{4};
+  for (size_t i = 0U; i != ints.len(); ++i) {
+    ints.set(i, (int) i);
+  }
+
+  Array<int> &items = ints.make_mut();
+  auto snapshot = ints.clone();
+  ASSERT(ints.is_unique() && snapshot.is_unique());
+  items[0] = 100;
+  ASSERT(ints[0] == 100);
+  ASSERT(snapshot[0] == 0);
+
+  auto iter = ints.iter_mut();
+  SharedArray<int> assigned{};
+  assigned = ints;
+  iter.for_each([](int &v) { v = -1; });
+  ASSERT(ints.iter().sum() == -4);
+  ASSERT(assigned.iter().sum() == 106);
+
+  // Copies that were never borrowed from are still shared
+  auto shared = assigned.clone();
+  ASSERT(&shared[0] == &assigned[0]);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_shared_array_default_ctor_works,
+    test_shared_array_clone_shares_buffer,
+    test_shared_array_copies_on_write,
+    test_shared_array_collect_works,
+    test_shared_array_iter_is_read_only,
+    test_shared_array_borrows_are_not_shared
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
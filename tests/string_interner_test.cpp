@@ -0,0 +1,117 @@
+#include "../unit_test.h"
+#include "../data_structures/array.h"
+#include "../data_structures/string_interner.h"
+
+UNIT_TEST(string_interner_intern_works) {
+  StringInterner interner{};
+
+  std::string foo = "foo";
+  auto first = interner.intern(foo);
+  foo[0] = 'b';
+  auto second = interner.intern("foo");
+
+  ASSERT(first == "foo");
+  ASSERT(first.data() == second.data());
+  ASSERT(interner.intern("boo").data() != first.data());
+  ASSERT(interner.len() == 2);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(string_interner_ids_work) {
+  StringInterner interner{};
+
+  ASSERT(interner.intern_id("a") == 0);
+  ASSERT(interner.intern_id("b") == 1);
+  ASSERT(interner.intern_id("a") == 0);
+  ASSERT(interner.intern_id("") == 2);
+  ASSERT(interner.intern_id("") == 2);
+  ASSERT(interner.resolve(1) == "b");
+  ASSERT(*interner.find("b") == 1);
+  ASSERT(!interner.find("c").has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(string_interner_growth_works) {
+  StringInterner interner{};
+
+  for (size_t i = 0U; i != 10000; ++i) {
+    ASSERT(interner.intern_id(std::to_string(i)) == i);
+  }
+  std::string big(StringInterner::CHUNK_SIZE, 'x');
+  auto big_view = interner.intern(big);
+
+  for (size_t i = 0U; i != 10000; ++i) {
+    ASSERT(interner.resolve(interner.intern_id(std::to_string(i))) == std::to_string(i));
+  }
+  ASSERT(interner.intern(big).data() == big_view.data());
+  ASSERT(interner.len() == 10001);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(string_interner_move_works) {
+  StringInterner interner{};
+  auto foo = interner.intern("foo");
+  interner.intern("bar");
+
+  StringInterner moved{std::move(interner)};
+  ASSERT(moved.len() == 2);
+  ASSERT(moved.intern("foo").data() == foo.data());
+
+  // The moved-from interner is empty, and can be used again
+  ASSERT(interner.len() == 0);
+  ASSERT(!interner.find("foo").has_value());
+  ASSERT(interner.intern_id("baz") == 0);
+  ASSERT(interner.intern("foo").data() != foo.data());
+  ASSERT(interner.len() == 2);
+
+  moved = std::move(interner);
+  ASSERT(moved.len() == 2 && *moved.find("baz") == 0);
+  ASSERT(interner.len() == 0);
+  ASSERT(interner.intern_id("qux") == 0);
+  ASSERT(moved.resolve(0) == "baz");
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(intern_works) {
+  Array<std::string> words{4};
+  words[0] = "foo";
+  words[1] = "bar";
+  words[2] = "foo";
+  words[3] = "bar";
+
+  StringInterner interner{};
+  auto interned = words.iter()
+      .intern(interner)
+      .collect<Array>();
+
+  ASSERT(interned.len() == 4);
+  ASSERT(interned[0] == "foo");
+  ASSERT(interned[1] == "bar");
+  ASSERT(interned[0].data() == interned[2].data());
+  ASSERT(interned[1].data() == interned[3].data());
+  ASSERT(interner.len() == 2);
+
+  auto ids = words.iter().intern_ids(interner);
+  ASSERT(*ids.next() == 0);
+  ASSERT(*ids.next() == 1);
+  ASSERT(*ids.next() == 0);
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_string_interner_intern_works,
+    test_string_interner_ids_work,
+    test_string_interner_growth_works,
+    test_string_interner_move_works,
+    test_intern_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -0,0 +1,212 @@
+#include "../unit_test.h"
+#include "../data_structures/array.h"
+#include "../text.h"
+
+template<typename IteratorType>
+bool yields(IteratorType iter, std::initializer_list<std::string_view> expected) {
+  for (std::string_view s : expected) {
+    auto v = iter.next();
+    if (!v.has_value() || *v != s) {
+      return false;
+    }
+  }
+  return !iter.next().has_value();
+}
+
+UNIT_TEST(split_works) {
+  ASSERT(yields(split("a,b,,c", ','), {"a", "b", "", "c"}));
+  ASSERT(yields(split(",a,", ','), {"", "a", ""}));
+  ASSERT(yields(split("", ','), {""}));
+  ASSERT(yields(split("abc", ','), {"abc"}));
+
+  std::string_view text = "key=value";
+  auto iter = split(text, '=');
+  ASSERT(iter.next()->data() == text.data());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(split_next_back_works) {
+  ASSERT(yields(split("a,b,,c", ',').rev(), {"c", "", "b", "a"}));
+  ASSERT(yields(split_str("a::b::c", "::").rev(), {"c", "b", "a"}));
+
+  auto iter = split("a,b,c,d", ',');
+  ASSERT(*iter.next() == "a");
+  ASSERT(*iter.next_back() == "d");
+  ASSERT(*iter.next() == "b");
+  ASSERT(*iter.next_back() == "c");
+  ASSERT(!iter.next().has_value());
+  ASSERT(!iter.next_back().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(split_str_works) {
+  ASSERT(yields(split_str("a::b::::c", "::"), {"a", "b", "", "c"}));
+  ASSERT(yields(split_str("a:b", "::"), {"a:b"}));
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(lines_works) {
+  ASSERT(yields(lines("first\r\nsecond\n\nthird\n"), {"first", "second", "", "third"}));
+  ASSERT(yields(lines("no newline"), {"no newline"}));
+  ASSERT(yields(lines("\n"), {""}));
+  ASSERT(yields(lines(""), {}));
+  ASSERT(yields(lines("a\nb\r\n").rev(), {"b", "a"}));
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(split_whitespace_works) {
+  ASSERT(yields(split_whitespace("  hello \t world\n"), {"hello", "world"}));
+  ASSERT(yields(split_whitespace("one"), {"one"}));
+  ASSERT(yields(split_whitespace(" \r\n\t "), {}));
+  ASSERT(yields(split_whitespace(" a bb  ccc ").rev(), {"ccc", "bb", "a"}));
+
+  auto words = split_whitespace("a b c").collect<Array>();
+  ASSERT(words.len() == 3);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(chars_works) {
+  // "añ€😀" in UTF-8
+  auto iter = chars("a\xC3\xB1\xE2\x82\xAC\xF0\x9F\x98\x80");
+  ASSERT(*iter.next() == U'a');
+  ASSERT(*iter.next() == U'\u00F1');
+  ASSERT(*iter.next() == U'\u20AC');
+  ASSERT(*iter.next() == U'\U0001F600');
+  ASSERT(!iter.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(chars_invalid_utf8_works) {
+  // Stray continuation byte, truncated sequence, surrogate and overlong encoding
+  auto iter = chars("\x80" "a" "\xE2\x82" "\xED\xA0\x80" "\xC0\xAF");
+  ASSERT(*iter.next() == U'\uFFFD');
+  ASSERT(*iter.next() == U'a');
+  ASSERT(*iter.next() == U'\uFFFD');
+  ASSERT(*iter.next() == U'\uFFFD');
+
+  ASSERT(!is_valid_utf8("\x80"));
+  ASSERT(!is_valid_utf8("\xE2\x82"));
+  ASSERT(!is_valid_utf8("\xED\xA0\x80"));
+  ASSERT(!is_valid_utf8("\xF4\x90\x80\x80"));
+  ASSERT(is_valid_utf8("plain ascii text that is long enough \xC3\xB1"));
+
+  auto invalid = chars("\xE2\x82" "abcdefghij");
+  ASSERT(invalid.count() == 12);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(chars_count_and_size_hint_work) {
+  std::string text{};
+  for (size_t i = 0U; i != 10; ++i) {
+    text += "abc\xC3\xB1\xE2\x82\xAC\xF0\x9F\x98\x80";
+  }
+
+  auto iter = chars(text);
+  auto[lower, upper] = iter.size_hint();
+  ASSERT(lower == (text.size() + 3) / 4);
+  ASSERT(*upper == text.size());
+
+  ASSERT(chars(text).count() == 60);
+  ASSERT(chars(text).count() == chars(text).skip(0).count());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(char_indices_works) {
+  auto iter = char_indices("\xC3\xB1" "b" "\xE2\x82\xAC");
+  auto v = iter.next();
+  ASSERT(v->first == 0 && v->second == U'\u00F1');
+  v = iter.next();
+  ASSERT(v->first == 2 && v->second == U'b');
+  v = iter.next();
+  ASSERT(v->first == 3 && v->second == U'\u20AC');
+  ASSERT(!iter.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(parse_works) {
+  auto ints = split("1,-2,x,4,,5a", ',').parse<int>();
+  ASSERT(*ints.next() == 1);
+  ASSERT(*ints.next() == -2);
+  ASSERT(*ints.next() == 4);
+  ASSERT(!ints.next().has_value());
+
+  auto doubles = split_whitespace("1.5 -2e3 nope").parse<double>();
+  ASSERT(*doubles.next() == 1.5);
+  ASSERT(*doubles.next() == -2000.0);
+  ASSERT(!doubles.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(parse_long_integers_works) {
+  auto longs = split("12345678,1234567890123456,-9876543210,00000001,1234567a", ',').parse<int64_t>();
+  ASSERT(*longs.next() == 12345678);
+  ASSERT(*longs.next() == 1234567890123456);
+  ASSERT(*longs.next() == -9876543210);
+  ASSERT(*longs.next() == 1);
+  ASSERT(!longs.next().has_value());
+
+  auto ints = split("2147483647,2147483648,-2147483648,-2147483649", ',').try_parse<int32_t>();
+  auto v = ints.next();
+  ASSERT(v->ok() && v->value == 2147483647);
+  ASSERT(ints.next()->error == std::errc::result_out_of_range);
+  v = ints.next();
+  ASSERT(v->ok() && v->value == INT32_MIN);
+  ASSERT(ints.next()->error == std::errc::result_out_of_range);
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(try_parse_works) {
+  auto iter = split("7,x,99999999999,", ',').try_parse<uint16_t>();
+  auto v = iter.next();
+  ASSERT(v->ok() && v->value == 7);
+  ASSERT(iter.next()->error == std::errc::invalid_argument);
+  ASSERT(iter.next()->error == std::errc::result_out_of_range);
+  ASSERT(iter.next()->error == std::errc::invalid_argument);
+  ASSERT(!iter.next().has_value());
+
+  TEST_PASSED();
+}
+
+UNIT_TEST(split_rposition_works) {
+  // Split can't tell how many items it has left, so its size hint is not exact
+  auto iter = split("a,b,a,c", ',');
+  ASSERT(!iter.size_hint().second.has_value());
+
+  ASSERT(*split("a,b,a,c", ',').rposition([](std::string_view s) { return s == "a"; }) == 2);
+  ASSERT(*split("a,b,a,c", ',').rposition([](std::string_view s) { return s == "c"; }) == 3);
+  ASSERT(!split("a,b,c", ',').rposition([](std::string_view s) { return s == "d"; }).has_value());
+
+  TEST_PASSED();
+}
+
+TestFn tests[] = {
+    test_split_works,
+    test_split_next_back_works,
+    test_split_str_works,
+    test_lines_works,
+    test_split_whitespace_works,
+    test_chars_works,
+    test_chars_invalid_utf8_works,
+    test_chars_count_and_size_hint_work,
+    test_char_indices_works,
+    test_parse_works,
+    test_parse_long_integers_works,
+    test_try_parse_works,
+    test_split_rposition_works
+};
+
+int main() {
+  constexpr size_t num_tests = sizeof(tests) / sizeof(tests[0]);
+  run_tests(tests, num_tests);
+}
@@ -0,0 +1,463 @@
+#ifndef ITERATOR__TEXT_H
+#define ITERATOR__TEXT_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "iterator.h"
+
+/**
+ * Summary:
+ *      An iterator over the substrings of a string separated by a pattern.
+ *      The pattern can be a single `char` or a `std::string_view`.
+ *      The substrings are `std::string_view`s into the original string, so
+ *      nothing is copied or allocated. Adjacent separators yield empty substrings.
+ *      The iterator can also be consumed from the back with `next_back` (or `rev`).
+ *      To get an iterator of this type, call `split` or `split_str`.
+ *
+ * @tparam Pattern: The type of the separator, `char` or `std::string_view`
+ *
+ * @example:
+ * ```
+ * auto fields = split("a,b,,c", ',').collect<Array>();
+ *
+ * // fields is: ["a", "b", "", "c"]
+ *
+ * auto last = split("/usr/local/bin", '/').next_back();
+ *
+ * // last.value() is "bin"
+ * ```
+ */
+template<typename Pattern>
+struct Split : public Iterator<std::string_view, Split<Pattern>> {
+  using ItemType = std::string_view;
+
+  Split(std::string_view text, Pattern pattern) : remaining{text}, pattern{pattern}, finished{false} {}
+
+  std::optional<ItemType> next() {
+    if (finished) {
+      return std::nullopt;
+    }
+
+    const size_t pos = find();
+    if (pos == std::string_view::npos) {
+      finished = true;
+      return std::make_optional(remaining);
+    }
+
+    auto res = remaining.substr(0U, pos);
+    remaining.remove_prefix(pos + pattern_len());
+    return std::make_optional(res);
+  }
+
+  std::optional<ItemType> next_back() {
+    if (finished) {
+      return std::nullopt;
+    }
+
+    const size_t pos = remaining.rfind(pattern);
+    if (pos == std::string_view::npos) {
+      finished = true;
+      return std::make_optional(remaining);
+    }
+
+    auto res = remaining.substr(pos + pattern_len());
+    remaining.remove_suffix(remaining.size() - pos);
+    return std::make_optional(res);
+  }
+
+  std::string_view remaining;
+  Pattern pattern;
+  bool finished;
+
+private:
+  [[nodiscard]] size_t pattern_len() const noexcept {
+    if constexpr (std::is_same_v<Pattern, char>) {
+      return 1U;
+    } else {
+      return pattern.size();
+    }
+  }
+
+  [[nodiscard]] size_t find() const noexcept {
+    if constexpr (std::is_same_v<Pattern, char>) {
+      if (remaining.empty()) {
+        return std::string_view::npos;
+      }
+      const void *p = memchr(remaining.data(), pattern, remaining.size());
+      return p ? static_cast<const char *>(p) - remaining.data() : std::string_view::npos;
+    } else {
+      return remaining.find(pattern);
+    }
+  }
+};
+
+/**
+ * Summary:
+ *      An iterator over the lines of a string.
+ *      Lines are terminated by `\n` or `\r\n` and the terminators are not
+ *      part of the yielded lines. A terminator at the very end of the string
+ *      does not produce an extra empty line.
+ *      To get an iterator of this type, call `lines`.
+ *
+ * @example:
+ * ```
+ * auto res = lines("first\r\nsecond\n\nthird\n").collect<Array>();
+ *
+ * // res is: ["first", "second", "", "third"]
+ * ```
+ */
+struct Lines : public Iterator<std::string_view, Lines> {
+  using ItemType = std::string_view;
+
+  explicit Lines(std::string_view text) : inner{text, '\n'} {
+    if (text.empty()) {
+      inner.finished = true;
+    } else if (text.back() == '\n') {
+      inner.remaining.remove_suffix(1U);
+    }
+  }
+
+  std::optional<ItemType> next() {
+    return strip_cr(inner.next());
+  }
+
+  std::optional<ItemType> next_back() {
+    return strip_cr(inner.next_back());
+  }
+
+  Split<char> inner;
+
+private:
+  static std::optional<ItemType> strip_cr(std::optional<ItemType> line) {
+    if (line.has_value() && !line->empty() && line->back() == '\r') {
+      line->remove_suffix(1U);
+    }
+    return line;
+  }
+};
+
+/**
+ * Summary:
+ *      An iterator over the words of a string. Words are separated by
+ *      any amount of ASCII whitespace, so no empty words are yielded.
+ *      To get an iterator of this type, call `split_whitespace`.
+ *
+ * @example:
+ * ```
+ * auto words = split_whitespace("  hello \t world\n").collect<Array>();
+ *
+ * // words is: ["hello", "world"]
+ * ```
+ */
+struct SplitWhitespace : public Iterator<std::string_view, SplitWhitespace> {
+  using ItemType = std::string_view;
+
+  explicit SplitWhitespace(std::string_view text) : remaining{text} {}
+
+  std::optional<ItemType> next() {
+    size_t start = 0U;
+    while (start != remaining.size() && is_whitespace(remaining[start])) {
+      ++start;
+    }
+    if (start == remaining.size()) {
+      remaining = {};
+      return std::nullopt;
+    }
+
+    size_t end = start;
+    while (end != remaining.size() && !is_whitespace(remaining[end])) {
+      ++end;
+    }
+
+    auto res = remaining.substr(start, end - start);
+    remaining.remove_prefix(end);
+    return std::make_optional(res);
+  }
+
+  std::optional<ItemType> next_back() {
+    size_t end = remaining.size();
+    while (end != 0U && is_whitespace(remaining[end - 1U])) {
+      --end;
+    }
+    if (end == 0U) {
+      remaining = {};
+      return std::nullopt;
+    }
+
+    size_t start = end;
+    while (start != 0U && !is_whitespace(remaining[start - 1U])) {
+      --start;
+    }
+
+    auto res = remaining.substr(start, end - start);
+    remaining.remove_suffix(remaining.size() - start);
+    return std::make_optional(res);
+  }
+
+  std::string_view remaining;
+
+private:
+  static constexpr bool is_whitespace(char c) noexcept {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+};
+
+namespace internal {
+/**
+ * Summary:
+ *      Decodes the UTF-8 sequence at the start of `text`, which must not be empty.
+ *
+ * @return: The code point and the length of the sequence in bytes.
+ *          The length is 0 if the sequence is invalid.
+ */
+inline std::pair<char32_t, size_t> decode_utf8(std::string_view text) noexcept {
+  const auto byte = [&text](size_t i) { return static_cast<unsigned char>(text[i]); };
+  const auto in = [](unsigned char b, unsigned char lo, unsigned char hi) { return b >= lo && b <= hi; };
+
+  const unsigned char b0 = byte(0U);
+  if (b0 < 0x80U) {
+    return {b0, 1U};
+  }
+
+  if (in(b0, 0xC2U, 0xDFU)) {
+    if (text.size() >= 2U && in(byte(1U), 0x80U, 0xBFU)) {
+      return {static_cast<char32_t>((b0 & 0x1FU) << 6U | (byte(1U) & 0x3FU)), 2U};
+    }
+  } else if (in(b0, 0xE0U, 0xEFU)) {
+    const unsigned char lo = b0 == 0xE0U ? 0xA0U : 0x80U;
+    const unsigned char hi = b0 == 0xEDU ? 0x9FU : 0xBFU;
+    if (text.size() >= 3U && in(byte(1U), lo, hi) && in(byte(2U), 0x80U, 0xBFU)) {
+      return {static_cast<char32_t>((b0 & 0x0FU) << 12U | (byte(1U) & 0x3FU) << 6U | (byte(2U) & 0x3FU)), 3U};
+    }
+  } else if (in(b0, 0xF0U, 0xF4U)) {
+    const unsigned char lo = b0 == 0xF0U ? 0x90U : 0x80U;
+    const unsigned char hi = b0 == 0xF4U ? 0x8FU : 0xBFU;
+    if (text.size() >= 4U && in(byte(1U), lo, hi) && in(byte(2U), 0x80U, 0xBFU) && in(byte(3U), 0x80U, 0xBFU)) {
+      return {static_cast<char32_t>((b0 & 0x07U) << 18U | (byte(1U) & 0x3FU) << 12U |
+                                    (byte(2U) & 0x3FU) << 6U | (byte(3U) & 0x3FU)), 4U};
+    }
+  }
+
+  return {0xFFFDU, 0U};
+}
+
+inline constexpr uint64_t HIGH_BITS = 0x8080808080808080U;
+
+inline uint64_t load_word(const char *p) noexcept {
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+}
+
+/**
+ * Summary:
+ *      Checks whether a string is valid UTF-8.
+ *      Blocks of 8 ASCII bytes are checked at once.
+ *
+ * @param text: The string to check
+ * @return:     true if `text` is valid UTF-8, false otherwise
+ */
+inline bool is_valid_utf8(std::string_view text) noexcept {
+  size_t i = 0U;
+  while (i != text.size()) {
+    if (text.size() - i >= 8U && (internal::load_word(text.data() + i) & internal::HIGH_BITS) == 0U) {
+      i += 8U;
+      continue;
+    }
+
+    const size_t len = internal::decode_utf8(text.substr(i)).second;
+    if (len == 0U) {
+      return false;
+    }
+    i += len;
+  }
+  return true;
+}
+
+/**
+ * Summary:
+ *      Counts the code points of a valid UTF-8 string by counting the bytes
+ *      that are not continuation bytes (`10xxxxxx`), 8 bytes at a time.
+ *
+ * @param text: A valid UTF-8 string
+ * @return:     The number of code points in `text`
+ */
+inline size_t count_code_points(std::string_view text) noexcept {
+  size_t continuations = 0U;
+  size_t i = 0U;
+  for (; text.size() - i >= 8U; i += 8U) {
+    const uint64_t word = internal::load_word(text.data() + i);
+    continuations += __builtin_popcountll(word & ~(word << 1U) & internal::HIGH_BITS);
+  }
+  for (; i != text.size(); ++i) {
+    continuations += (static_cast<unsigned char>(text[i]) & 0xC0U) == 0x80U;
+  }
+  return text.size() - continuations;
+}
+
+/**
+ * Summary:
+ *      An iterator over the code points of a UTF-8 string.
+ *      Each invalid byte is yielded as U+FFFD (the replacement character),
+ *      so iterating never fails.
+ *      `count` is computed by counting bytes, without decoding, when
+ *      the remaining string is valid UTF-8.
+ *      To get an iterator of this type, call `chars`.
+ *
+ * @example:
+ * ```
+ * auto res = chars("añb").collect<Array>();
+ *
+ * // res is: [U'a', U'ñ', U'b']
+ * ```
+ */
+struct Chars : public Iterator<char32_t, Chars> {
+  using ItemType = char32_t;
+
+  explicit Chars(std::string_view text) : remaining{text} {}
+
+  std::optional<ItemType> next() {
+    if (remaining.empty()) {
+      return std::nullopt;
+    }
+
+    if (static_cast<unsigned char>(remaining[0]) < 0x80U) {
+      const char32_t c = static_cast<unsigned char>(remaining[0]);
+      remaining.remove_prefix(1U);
+      return std::make_optional(c);
+    }
+
+    auto[c, len] = internal::decode_utf8(remaining);
+    remaining.remove_prefix(len == 0U ? 1U : len);
+    return std::make_optional(c);
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return {(remaining.size() + 3U) / 4U, std::make_optional(remaining.size())};
+  }
+
+  size_t count() {
+    if (is_valid_utf8(remaining)) {
+      const size_t res = count_code_points(remaining);
+      remaining = {};
+      return res;
+    }
+    return Iterator<char32_t, Chars>::count();
+  }
+
+  std::string_view remaining;
+};
+
+/**
+ * Summary:
+ *      An iterator over the code points of a UTF-8 string and their
+ *      byte offsets in the string. It yields `std::pair<size_t, char32_t>`.
+ *      To get an iterator of this type, call `char_indices`.
+ *
+ * @example:
+ * ```
+ * auto res = char_indices("ñb").collect<Array>();
+ *
+ * // res is: [(0, U'ñ'), (2, U'b')]
+ * ```
+ */
+struct CharIndices : public Iterator<std::pair<size_t, char32_t>, CharIndices> {
+  using ItemType = std::pair<size_t, char32_t>;
+
+  explicit CharIndices(std::string_view text) : inner{text}, start{text.data()} {}
+
+  std::optional<ItemType> next() {
+    const auto index = static_cast<size_t>(inner.remaining.data() - start);
+    auto c = inner.next();
+    if (c.has_value()) {
+      return std::make_optional(std::make_pair(index, *c));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  [[nodiscard]] std::pair<size_t, std::optional<size_t>> size_hint() const {
+    return inner.size_hint();
+  }
+
+  size_t count() {
+    return inner.count();
+  }
+
+  Chars inner;
+  const char *start;
+};
+
+/**
+ * Summary:
+ *      Splits a string on every occurrence of a character
+ *
+ * @param text: The string to split
+ * @param sep:  The separator
+ * @return:     A `Split` iterator
+ */
+inline Split<char> split(std::string_view text, char sep) {
+  return Split<char>(text, sep);
+}
+
+/**
+ * Summary:
+ *      Splits a string on every occurrence of a (non empty) separator string
+ *
+ * @param text: The string to split
+ * @param sep:  The separator
+ * @return:     A `Split` iterator
+ */
+inline Split<std::string_view> split_str(std::string_view text, std::string_view sep) {
+  assert(!sep.empty());
+  return Split<std::string_view>(text, sep);
+}
+
+/**
+ * Summary:
+ *      Splits a string into lines
+ *
+ * @param text: The string to split
+ * @return:     A `Lines` iterator
+ */
+inline Lines lines(std::string_view text) {
+  return Lines(text);
+}
+
+/**
+ * Summary:
+ *      Splits a string into whitespace separated words
+ *
+ * @param text: The string to split
+ * @return:     A `SplitWhitespace` iterator
+ */
+inline SplitWhitespace split_whitespace(std::string_view text) {
+  return SplitWhitespace(text);
+}
+
+/**
+ * Summary:
+ *      Iterates over the code points of a UTF-8 string
+ *
+ * @param text: The UTF-8 string
+ * @return:     A `Chars` iterator
+ */
+inline Chars chars(std::string_view text) {
+  return Chars(text);
+}
+
+/**
+ * Summary:
+ *      Iterates over the code points of a UTF-8 string along with their byte offsets
+ *
+ * @param text: The UTF-8 string
+ * @return:     A `CharIndices` iterator
+ */
+inline CharIndices char_indices(std::string_view text) {
+  return CharIndices(text);
+}
+
+#endif //ITERATOR__TEXT_H